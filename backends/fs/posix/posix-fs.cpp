@@ -31,6 +31,9 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit		//Needed for IRIX's unistd.h
 
 #include "backends/fs/posix/posix-fs.h"
+#ifdef POSIX
+#include "backends/fs/posix/posix-mmap-stream.h"
+#endif
 #include "backends/fs/stdiostream.h"
 #include "common/algorithm.h"
 
@@ -251,7 +254,25 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+#ifdef POSIX
+	// Open the file only once, then map larger files into memory and read
+	// the others through stdio
+	const int fd = open(_path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return 0;
+
+	if (!PosixMmapStream::isExcluded(_path)) {
+		Common::SeekableReadStream *stream = PosixMmapStream::makeFromDescriptor(fd);
+		if (stream) {
+			close(fd);
+			return stream;
+		}
+	}
+
+	return StdioStream::makeFromDescriptor(fd);
+#else
 	return StdioStream::makeFromPath(getPath(), false);
+#endif
 }
 
 Common::WriteStream *POSIXFilesystemNode::createWriteStream() {
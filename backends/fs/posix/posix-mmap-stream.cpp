@@ -0,0 +1,83 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#if defined(POSIX)
+
+// Disable symbol overrides so that we can use open, close etc.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/posix/posix-mmap-stream.h"
+
+#include <unistd.h>
+
+Common::String PosixMmapStream::_excludedPrefix;
+
+void PosixMmapStream::setExcludedDirectory(const Common::String &path) {
+	_excludedPrefix = path;
+	if (!_excludedPrefix.empty() && !_excludedPrefix.hasSuffix("/"))
+		_excludedPrefix += '/';
+}
+
+bool PosixMmapStream::isExcluded(const Common::String &path) {
+	return !_excludedPrefix.empty() && path.hasPrefix(_excludedPrefix);
+}
+
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+PosixMmapStream *PosixMmapStream::makeFromDescriptor(int fd) {
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+	    st.st_size < (off_t)kMinMapSize || st.st_size > (off_t)kMaxMapSize)
+		return 0;
+
+	// The mapping stays valid after the descriptor is closed
+	void *mapping = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mapping == MAP_FAILED)
+		return 0;
+
+	return new PosixMmapStream(mapping, (uint32)st.st_size);
+}
+
+PosixMmapStream::PosixMmapStream(void *mapping, uint32 size) :
+	Common::MemoryReadStream((const byte *)mapping, size), _mapping(mapping), _mapSize(size) {
+}
+
+PosixMmapStream::~PosixMmapStream() {
+	munmap(_mapping, _mapSize);
+}
+
+#else
+
+PosixMmapStream *PosixMmapStream::makeFromDescriptor(int) {
+	return 0;
+}
+
+PosixMmapStream::~PosixMmapStream() {
+}
+
+#endif
+
+#endif
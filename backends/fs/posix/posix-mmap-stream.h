@@ -0,0 +1,86 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef BACKENDS_FS_POSIX_MMAP_STREAM_H
+#define BACKENDS_FS_POSIX_MMAP_STREAM_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/str.h"
+
+/**
+ * Read stream over a file which is mapped into memory with mmap().
+ *
+ * Reads are plain memory copies, and the mapped file contents are
+ * available without any copy through MemoryReadStream::getData().
+ *
+ * If the file is truncated while it is mapped, accessing the part past
+ * the new end raises SIGBUS instead of failing the read. Only use this
+ * for files which are not written to while the game runs, i.e. not for
+ * savefiles.
+ */
+class PosixMmapStream : public Common::MemoryReadStream {
+public:
+	/**
+	 * Files smaller than this are read through StdioStream, as mapping
+	 * them costs more than it saves.
+	 */
+	static const uint32 kMinMapSize = 64 * 1024;
+
+	/**
+	 * Files larger than this are read through StdioStream, so that large
+	 * files don't use up the address space of 32-bit targets.
+	 */
+	static const uint32 kMaxMapSize = (sizeof(void *) > 4) ? 0x7FFFFFFF : 64 * 1024 * 1024;
+
+	/**
+	 * Map the regular file open for reading with the given descriptor,
+	 * which is left open. Returns 0 if the file is too small or too large
+	 * to be mapped, or if mapping it failed, so that the caller can fall
+	 * back to StdioStream.
+	 */
+	static PosixMmapStream *makeFromDescriptor(int fd);
+
+	/**
+	 * Set the directory whose files are never mapped, since they are
+	 * rewritten while the game runs: the savefile directory. The path
+	 * has to be normalized like the ones of POSIXFilesystemNode.
+	 */
+	static void setExcludedDirectory(const Common::String &path);
+
+	/** Check whether the file at the given path may be mapped. */
+	static bool isExcluded(const Common::String &path);
+
+	virtual ~PosixMmapStream();
+
+private:
+	PosixMmapStream(void *mapping, uint32 size);
+
+	void *_mapping;
+	uint32 _mapSize;
+
+	/** The excluded directory, with a trailing slash, or empty. */
+	static Common::String _excludedPrefix;
+};
+
+#endif
@@ -103,4 +103,17 @@ StdioStream *StdioStream::makeFromPath(const Common::String &path, bool writeMod
 	return 0;
 }
 
+#ifdef POSIX
+#include <unistd.h>
+
+StdioStream *StdioStream::makeFromDescriptor(int fd) {
+	FILE *handle = fdopen(fd, "rb");
+	if (handle)
+		return new StdioStream(handle);
+
+	close(fd);
+	return 0;
+}
+#endif
+
 #endif
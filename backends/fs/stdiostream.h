@@ -40,6 +40,15 @@ public:
 	 */
 	static StdioStream *makeFromPath(const Common::String &path, bool writeMode);
 
+#ifdef POSIX
+	/**
+	 * Given a file descriptor opened for reading, invokes fdopen on it and
+	 * wrap the result in a StdioStream instance. The stream takes over the
+	 * descriptor, which is closed if this fails.
+	 */
+	static StdioStream *makeFromDescriptor(int fd);
+#endif
+
 	StdioStream(void *handle);
 	virtual ~StdioStream();
 
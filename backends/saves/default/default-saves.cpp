@@ -43,6 +43,10 @@
 #include "common/config-manager.h"
 #include "common/zlib.h"
 
+#ifdef POSIX
+#include "backends/fs/posix/posix-mmap-stream.h"
+#endif
+
 #ifndef _WIN32_WCE
 #include <errno.h>	// for removeSavefile()
 #endif
@@ -168,6 +172,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Open the file for saving.
 	Common::WriteStream *const sf = fileNode.createWriteStream();
+	if (!sf)
+		return nullptr;
 	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
 
 	// Add file to cache now that it exists.
@@ -260,6 +266,12 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 	_saveFileCache.clear();
 	_cachedDirectory.clear();
 
+#ifdef POSIX
+	// Savefiles are rewritten while the game runs, so they must not be
+	// mapped into memory
+	PosixMmapStream::setExcludedDirectory(savePathName.empty() ? savePathName : Common::FSNode(savePathName).getPath());
+#endif
+
 	if (getError().getCode() != Common::kNoError) {
 		warning("DefaultSaveFileManager::assureCached: Can not cache path '%s': '%s'", savePathName.c_str(), getErrorDesc().c_str());
 		return;
@@ -26,6 +26,8 @@
 #include "common/debug.h"
 #include "common/config-manager.h"
 
+#include "engines/advancedDetector.h"
+
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
 #endif
@@ -518,6 +520,8 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 	GameList candidates;
 	EnginePlugin::List plugins;
 	EnginePlugin::List::const_iterator iter;
+	// Let all engines share the subdirectory listings of this directory
+	AdvancedMetaEngine::beginDetectionRun();
 	PluginManager::instance().loadFirstPlugin();
 	do {
 		plugins = getPlugins();
@@ -527,6 +531,7 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 			candidates.push_back((**iter)->detectGames(fslist));
 		}
 	} while (PluginManager::instance().loadNextPlugin());
+	AdvancedMetaEngine::endDetectionRun();
 	return candidates;
 }
 
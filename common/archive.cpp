@@ -21,6 +21,7 @@
  */
 
 #include "common/archive.h"
+#include "common/debug.h"
 #include "common/fs.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -85,7 +86,102 @@ SearchSet::ArchiveNodeList::const_iterator SearchSet::find(const String &name) c
     In case two or node nodes have the same priority, insertion
     order prevails.
 */
+SearchSet::SearchSet() : _lookupCacheVersion(0), _changes(0), _lookups(0), _cacheHits(0), _probesSaved(0) {
+}
+
+// The archives themselves are looked up by String
+static inline const String &memberName(const String &name) {
+	return name;
+}
+
+static inline const String &memberName(const InternedString &name) {
+	return name.toString();
+}
+
+template<class Cache, class Key>
+const SearchSet::LookupCacheEntry *SearchSet::getCachedLookup(Cache &cache, const Key &name) const {
+	_lookups++;
+
+	const uint32 version = getContentsVersion();
+	if (_lookupCacheVersion != version) {
+		flushLookupCaches();
+		_lookupCacheVersion = version;
+		return 0;
+	}
+
+	typename Cache::const_iterator it = cache.find(name);
+	if (it == cache.end())
+		return 0;
+
+	_cacheHits++;
+	_probesSaved += it->_value._probes;
+	return &it->_value;
+}
+
+template<class Cache, class Key>
+void SearchSet::cacheLookup(Cache &cache, const Key &name, Archive *arc, uint probes) const {
+	// Programs probing many different names, e.g. while detecting games,
+	// must not make the cache grow without bounds
+	if (cache.size() >= kLookupCacheMaxEntries)
+		cache.clear();
+
+	cache.setVal(name, LookupCacheEntry(arc, probes));
+}
+
+template<class Cache, class Key>
+Archive *SearchSet::findArchive(Cache &cache, const Key &name) const {
+	const LookupCacheEntry *entry = getCachedLookup(cache, name);
+	if (entry)
+		return entry->_arc;
+
+	uint probes = 0;
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		probes++;
+		if (it->_arc->hasFile(memberName(name))) {
+			cacheLookup(cache, name, it->_arc, probes);
+			return it->_arc;
+		}
+	}
+
+	cacheLookup(cache, name, (Archive *)0, probes);
+	return 0;
+}
+
+template<class Cache, class Key>
+SeekableReadStream *SearchSet::openMember(Cache &cache, const Key &name) const {
+	const LookupCacheEntry *entry = getCachedLookup(cache, name);
+	if (entry) {
+		if (!entry->_arc)
+			return 0;
+
+		SeekableReadStream *stream = entry->_arc->createReadStreamForMember(memberName(name));
+		if (stream)
+			return stream;
+
+		// The archive failed to open the file after all, so fall back to
+		// trying all of them
+	}
+
+	uint probes = 0;
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		probes++;
+		SeekableReadStream *stream = it->_arc->createReadStreamForMember(memberName(name));
+		if (stream) {
+			cacheLookup(cache, name, it->_arc, probes);
+			return stream;
+		}
+	}
+
+	cacheLookup(cache, name, (Archive *)0, probes);
+	return 0;
+}
+
 void SearchSet::insert(const Node &node) {
+	_changes++;
+	flushLookupCaches();
+
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_priority < node._priority)
@@ -170,9 +266,12 @@ void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPa
 void SearchSet::remove(const String &name) {
 	ArchiveNodeList::iterator it = find(name);
 	if (it != _list.end()) {
+		// Keep the contents version growing, see getContentsVersion()
+		_changes += it->_arc->getContentsVersion() + 1;
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		flushLookupCaches();
 	}
 }
 
@@ -181,12 +280,27 @@ bool SearchSet::hasArchive(const String &name) const {
 }
 
 void SearchSet::clear() {
+	// Keep the contents version growing, see getContentsVersion()
+	for (ArchiveNodeList::iterator i = _list.begin(); i != _list.end(); ++i)
+		_changes += i->_arc->getContentsVersion();
+	_changes++;
+
+	freeArchives();
+}
+
+void SearchSet::freeArchives() {
 	for (ArchiveNodeList::iterator i = _list.begin(); i != _list.end(); ++i) {
 		if (i->_autoFree)
 			delete i->_arc;
 	}
 
 	_list.clear();
+	flushLookupCaches();
+}
+
+void SearchSet::flushLookupCaches() const {
+	_lookupCache.clear();
+	_internedLookupCache.clear();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -205,17 +319,22 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
+uint32 SearchSet::getContentsVersion() const {
+	// Every counter only ever grows, and the versions of removed archives
+	// are added to _changes, so the sum changes whenever any of them does
+	uint32 version = _changes;
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it)
+		version += it->_arc->getContentsVersion();
+
+	return version;
+}
+
 bool SearchSet::hasFile(const String &name) const {
 	if (name.empty())
 		return false;
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return true;
-	}
-
-	return false;
+	return findArchive(_lookupCache, name) != 0;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
@@ -242,27 +361,32 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return it->_arc->getMember(name);
-	}
+	Archive *arc = findArchive(_lookupCache, name);
+	if (!arc)
+		return ArchiveMemberPtr();
 
-	return ArchiveMemberPtr();
+	return arc->getMember(name);
 }
 
 SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) const {
 	if (name.empty())
 		return 0;
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
-		if (stream)
-			return stream;
-	}
+	return openMember(_lookupCache, name);
+}
 
-	return 0;
+bool SearchSet::hasFile(const InternedString &name) const {
+	if (name.empty())
+		return false;
+
+	return findArchive(_internedLookupCache, name) != 0;
+}
+
+SeekableReadStream *SearchSet::createReadStreamForMember(const InternedString &name) const {
+	if (name.empty())
+		return 0;
+
+	return openMember(_internedLookupCache, name);
 }
 
 
@@ -271,6 +395,12 @@ SearchManager::SearchManager() {
 }
 
 void SearchManager::clear() {
+	if (_lookups) {
+		debug(2, "SearchManager: %u of %u file lookups answered by the lookup cache, saving %u archive probes",
+		      _cacheHits, _lookups, _probesSaved);
+		_lookups = _cacheHits = _probesSaved = 0;
+	}
+
 	SearchSet::clear();
 
 	// Always keep system specific archives in the SearchManager.
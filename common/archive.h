@@ -24,6 +24,8 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
+#include "common/interned-str.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -123,6 +125,13 @@ public:
 	 * @return the newly created input stream
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const = 0;
+
+	/**
+	 * Return a number which changes whenever members are added to or
+	 * removed from the archive, so that lookups cached by the caller can be
+	 * checked. Archives whose members never change return 0.
+	 */
+	virtual uint32 getContentsVersion() const { return 0; }
 };
 
 
@@ -146,14 +155,80 @@ class SearchSet : public Archive {
 	typedef List<Node> ArchiveNodeList;
 	ArchiveNodeList _list;
 
+	/**
+	 * Lookup caches, mapping file names to the archive which contains them,
+	 * or to 0 if no archive does. They are flushed when the contents version
+	 * of this set changes, which also covers archives nested in it, and
+	 * when they reach kLookupCacheMaxEntries.
+	 *
+	 * Interned names have a cache of their own, which uses their stored
+	 * hash and compares them by identity.
+	 *
+	 * Since lookups fill the caches, a SearchSet must not be searched from
+	 * several threads at once, e.g. from the main thread and from a timer
+	 * or mixer callback, without a lock held by the caller.
+	 */
+	struct LookupCacheEntry {
+		Archive *_arc;
+		uint _probes;	///< Number of archives probed to find _arc
+
+		LookupCacheEntry() : _arc(0), _probes(0) {}
+		LookupCacheEntry(Archive *arc, uint probes) : _arc(arc), _probes(probes) {}
+	};
+	typedef HashMap<String, LookupCacheEntry> LookupCache;
+	mutable LookupCache _lookupCache;
+	typedef HashMap<InternedString, LookupCacheEntry> InternedLookupCache;
+	mutable InternedLookupCache _internedLookupCache;
+	mutable uint32 _lookupCacheVersion;
+
+	enum {
+		kLookupCacheMaxEntries = 1024
+	};
+
+	/** Incremented whenever archives are added to or removed from this set */
+	uint32 _changes;
+
 	ArchiveNodeList::iterator find(const String &name);
 	ArchiveNodeList::const_iterator find(const String &name) const;
 
 	// Add an archive keeping the list sorted by descending priority.
 	void insert(const Node& node);
 
+	// Remove all archives, deleting the ones owned by the set
+	void freeArchives();
+
+	void flushLookupCaches() const;
+
+	/**
+	 * Return the cache entry for the given name, or 0 if it is not cached
+	 * yet. Flushes the caches if the set of archives changed.
+	 */
+	template<class Cache, class Key>
+	const LookupCacheEntry *getCachedLookup(Cache &cache, const Key &name) const;
+
+	// Store the result of a lookup, flushing the cache if it is full
+	template<class Cache, class Key>
+	void cacheLookup(Cache &cache, const Key &name, Archive *arc, uint probes) const;
+
+	// Return the first archive which has a file of the given name, or 0
+	template<class Cache, class Key>
+	Archive *findArchive(Cache &cache, const Key &name) const;
+
+	// Open the file of the given name from the first archive which has it
+	template<class Cache, class Key>
+	SeekableReadStream *openMember(Cache &cache, const Key &name) const;
+
+protected:
+	/** Statistics about the lookup cache. */
+	mutable uint32 _lookups;
+	mutable uint32 _cacheHits;
+	mutable uint32 _probesSaved;
+
 public:
-	virtual ~SearchSet() { clear(); }
+	SearchSet();
+	// Nested archives not owned by this set may be gone already, so they
+	// are not asked for their contents version here
+	virtual ~SearchSet() { freeArchives(); }
 
 	/**
 	 * Add a new archive to the searchable set.
@@ -247,6 +322,19 @@ public:
 	 * opening the first file encountered that matches the name.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+	/**
+	 * Changes when archives are added to or removed from this set, or when
+	 * the contents of any archive in it change.
+	 */
+	virtual uint32 getContentsVersion() const;
+
+	/**
+	 * Variants of hasFile and createReadStreamForMember taking an interned
+	 * name, for callers which look up the same names over and over again.
+	 */
+	bool hasFile(const InternedString &name) const;
+	SeekableReadStream *createReadStreamForMember(const InternedString &name) const;
 };
 
 
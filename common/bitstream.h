@@ -134,6 +134,19 @@ private:
 		return b;
 	}
 
+	/** Return the number of bits of the current value not read yet. */
+	inline uint32 bitsLeftInValue() const {
+		return _inValue ? valueBits - _inValue : 0;
+	}
+
+	/** Return the first n bits (0 < n < 32) of a value positioned like _value. */
+	static inline uint32 firstBits(uint32 value, uint32 n) {
+		if (isMSB2LSB)
+			return value >> (32 - n);
+		else
+			return value & ((1U << n) - 1);
+	}
+
 public:
 	/** Read a bit from the bit stream. */
 	uint32 getBit() {
@@ -232,21 +245,61 @@ public:
 	 * The bit order is the same as in getBits().
 	 */
 	uint32 peekBits(uint8 n) {
-		uint32 value   = _value;
-		uint8  inValue = _inValue;
-		uint32 curStreamPos  = _stream->pos();
-		uint32 curPos = _pos;
+		if (n == 0)
+			return 0;
 
-		uint32 v = getBits(n);
+		if (n > 32)
+			error("BitStreamImpl::peekBits(): Too many bits requested to be read");
+
+		// Usually, the bits are all still in the current value
+		const uint32 left = bitsLeftInValue();
+		if (n <= left)
+			return firstBits(_value, n);
+
+		// Otherwise, combine them with the following data values, which are
+		// read without touching the current one, and seek back afterwards
+		uint32 v = left ? firstBits(_value, left) : 0;
+		uint32 got = left;
+
+		const uint32 curStreamPos = _stream->pos();
+		while (got < n) {
+			if (_size - _pos - got < valueBits)
+				error("BitStreamImpl::peekBits(): End of bit stream reached");
+
+			uint32 data = readData();
+			if (_stream->err() || _stream->eos())
+				error("BitStreamImpl::peekBits(): Read error");
+
+			const uint32 count = MIN<uint32>(n - got, valueBits);
+			if (isMSB2LSB) {
+				data >>= valueBits - count;
+				v = (count == 32) ? data : ((v << count) | data);
+			} else {
+				if (count < 32)
+					data &= (1U << count) - 1;
+				v |= data << got;
+			}
 
-		_pos     = curPos;
+			got += count;
+		}
 		_stream->seek(curStreamPos);
-		_inValue = inValue;
-		_value   = value;
 
 		return v;
 	}
 
+	/**
+	 * Peek at the next bits, as far as they are available without reading
+	 * from the stream, which is at least one bit unless the position is at
+	 * a data value border. n is the maximum number of bits to peek at, and
+	 * receives the number of bits returned.
+	 *
+	 * The bit order is the same as in getBits().
+	 */
+	uint32 peekBufferedBits(uint8 &n) const {
+		n = MIN<uint32>(n, bitsLeftInValue());
+		return n ? firstBits(_value, n) : 0;
+	}
+
 	/**
 	 * Add a bit to the value x, making it an n+1-bit value.
 	 *
@@ -279,8 +332,39 @@ public:
 
 	/** Skip the specified amount of bits. */
 	void skip(uint32 n) {
-		while (n-- > 0)
-			getBit();
+		// Use up the current value first
+		const uint32 left = bitsLeftInValue();
+		if (n <= left) {
+			if (isMSB2LSB)
+				_value <<= n;
+			else
+				_value >>= n;
+
+			_inValue = (_inValue + n) % valueBits;
+			_pos += n;
+			return;
+		}
+
+		n -= left;
+		_pos += left;
+		_inValue = 0;
+
+		// Then whole values, and the bits of the value the skip ends in
+		while (n > 0) {
+			readValue();
+
+			const uint32 count = MIN<uint32>(n, valueBits);
+			if (count < 32) {
+				if (isMSB2LSB)
+					_value <<= count;
+				else
+					_value >>= count;
+			}
+
+			_inValue = count % valueBits;
+			_pos += count;
+			n -= count;
+		}
 	}
 
 	/** Skip the bits to closest data value border. */
@@ -289,6 +373,11 @@ public:
 			getBit();
 	}
 
+	/** Return whether the bits are handed out in MSB to LSB order. */
+	static bool isMSB2LSBOrder() {
+		return isMSB2LSB;
+	}
+
 	/** Return the stream position in bits. */
 	uint32 pos() const {
 		return _pos;
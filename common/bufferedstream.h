@@ -50,6 +50,24 @@ ReadStream *wrapBufferedReadStream(ReadStream *parentStream, uint32 bufSize, Dis
  */
 SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream);
 
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream which
+ * reads ahead of the current position, for data which is mostly streamed
+ * sequentially from slow media.
+ * The wrapper starts with small reads from the parent stream and doubles
+ * their size, up to maxReadAhead bytes, as long as the data is consumed
+ * sequentially. Seeks back into the data already read are served from
+ * memory, while seeks elsewhere fall back to small reads again, so that
+ * seek heavy access does not read much data in vain.
+ *
+ * Streams which keep their data in memory gain nothing from this. If the
+ * wrapper would dispose such a stream anyway, it is returned as it is.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+SeekableReadStream *wrapReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxReadAhead, DisposeAfterUse::Flag disposeParentStream);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream which
  * transparently provides buffering.
@@ -143,6 +143,16 @@ uint32 File::read(void *ptr, uint32 len) {
 	return _handle->read(ptr, len);
 }
 
+const byte *File::borrowData(uint32 dataSize) {
+	assert(_handle);
+	return _handle->borrowData(dataSize);
+}
+
+bool File::hasDataInMemory() const {
+	assert(_handle);
+	return _handle->hasDataInMemory();
+}
+
 
 DumpFile::DumpFile() : _handle(0) {
 }
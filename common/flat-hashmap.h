@@ -0,0 +1,511 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef COMMON_FLAT_HASHMAP_H
+#define COMMON_FLAT_HASHMAP_H
+
+#include "common/scummsys.h"
+#include "common/func.h"
+#include "common/util.h"
+
+#include <new>
+
+namespace Common {
+
+/**
+ * FlatHashMap<Key,Val> has the same interface as HashMap<Key,Val> and uses
+ * the same hash and equality functors, so a map can be switched between
+ * the two by changing its type only.
+ *
+ * Instead of an array of pointers to separately allocated nodes, it keeps
+ * the nodes themselves in one flat array, next to an array with one
+ * metadata byte per slot. Collisions are resolved by linear probing with
+ * Robin Hood hashing, and erasing shifts the following nodes back instead
+ * of leaving tombstones. Lookups hence mostly touch a single cache line,
+ * which makes this the better choice for maps that are read far more often
+ * than they are modified, like string keyed symbol and config tables.
+ *
+ * Nodes are moved around by swapping their keys and values with default
+ * constructed ones, so in addition to the value, the key type has to be
+ * default constructible, and should be cheap to SWAP.
+ *
+ * Unlike HashMap, it is not a drop-in replacement, since:
+ * - Inserting a new key may move the other nodes, so references to values
+ *   and iterators are only valid until the next insertion.
+ * - Erasing an element moves later elements back by one slot. Code erasing
+ *   elements while iterating has to continue with the iterator returned
+ *   by erase(), instead of incrementing the erased one.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> HM_t;
+
+	struct Node {
+		Key _key;
+		Val _value;
+		Node() : _key(), _value() {}
+		explicit Node(const Key &key) : _key(key), _value() {}
+	};
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage may fill up before being increased automatically.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 3,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 4,
+
+		// Probe distances are stored in a byte; longer ones force a rehash
+		FLATHASHMAP_MAX_DISTANCE = 255
+	};
+
+	Node *_nodes;		///< node storage, only constructed where _distance is non-zero
+	byte *_distance;	///< per slot: 0 if empty, else 1 + distance from the home slot
+	size_type _mask;	///< Capacity of the map minus one; capacity is a power of two
+	uint _shift;		///< 32 minus the log2 of the capacity, see homeSlot()
+	size_type _size;
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/** Default value, returned by the const getVal. */
+	const Val _defaultVal;
+
+	static const size_type NONE_FOUND = (size_type)-1;
+
+	void allocStorage(size_type capacity) {
+		_mask = capacity - 1;
+		_shift = 32;
+		while (capacity > 1) {
+			capacity >>= 1;
+			_shift--;
+		}
+		_nodes = (Node *)malloc((_mask + 1) * sizeof(Node));
+		_distance = (byte *)calloc(_mask + 1, 1);
+		assert(_nodes != NULL && _distance != NULL);
+	}
+
+	void freeStorage() {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_distance[ctr])
+				_nodes[ctr].~Node();
+		}
+		free(_nodes);
+		free(_distance);
+	}
+
+	/**
+	 * Return the slot a key would ideally be stored in. The hash is mixed
+	 * by a Fibonacci multiplication, of which the top bits are used, since
+	 * hash functions like the one of integers do not vary the low bits of
+	 * keys sharing them, which would then all start in the same slot.
+	 */
+	size_type homeSlot(const Key &key) const {
+		return (size_type)((uint32)(_hash(key) * 2654435769U) >> _shift) & _mask;
+	}
+
+	/** Move the node of the slot src into the empty slot dst. */
+	void moveNode(size_type dst, Node &src) {
+		new ((void *)&_nodes[dst]) Node();
+		SWAP(_nodes[dst]._key, src._key);
+		SWAP(_nodes[dst]._value, src._value);
+		src.~Node();
+	}
+
+	/** Return the first empty slot; the load factor ensures there is one. */
+	size_type firstEmpty() const {
+		size_type ctr = 0;
+		while (_distance[ctr])
+			ctr++;
+		return ctr;
+	}
+
+	void assign(const HM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	bool makeRoom(size_type home, size_type &slot, bool moveNodes);
+	void expandStorage(size_type newCapacity);
+	void eraseSlot(size_type ctr);
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		size_type _end;		///< Empty slot at which the iteration wraps around
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, size_type end, hashmap_t *hashmap) : _idx(idx), _end(end), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != 0);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->_distance[_idx] != 0);
+			return &_hashmap->_nodes[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _end(0), _hashmap(0) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _end(c._end), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx = (_idx + 1) & _hashmap->_mask;
+			} while (_idx != _end && _hashmap->_distance[_idx] == 0);
+			if (_idx == _end)
+				_idx = NONE_FOUND;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap() : _size(0), _defaultVal() {
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	}
+
+	FlatHashMap(const HM_t &map) : _defaultVal() {
+		assign(map);
+	}
+
+	~FlatHashMap() {
+		freeStorage();
+	}
+
+	HM_t &operator=(const HM_t &map) {
+		if (this == &map)
+			return *this;
+
+		freeStorage();
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const {
+		return lookup(key) != NONE_FOUND;
+	}
+
+	Val &operator[](const Key &key) { return getVal(key); }
+	const Val &operator[](const Key &key) const { return getVal(key); }
+
+	Val &getVal(const Key &key) {
+		// Look up first: the lookup may reallocate _nodes
+		const size_type ctr = lookupAndCreateIfMissing(key);
+		return _nodes[ctr]._value;
+	}
+
+	const Val &getVal(const Key &key) const {
+		return getVal(key, _defaultVal);
+	}
+
+	const Val &getVal(const Key &key, const Val &defaultVal) const {
+		const size_type ctr = lookup(key);
+		return ctr != NONE_FOUND ? _nodes[ctr]._value : defaultVal;
+	}
+
+	void setVal(const Key &key, const Val &val) {
+		const size_type ctr = lookupAndCreateIfMissing(key);
+		_nodes[ctr]._value = val;
+	}
+
+	void clear(bool shrinkArray = 0);
+
+	/**
+	 * Erase the element the iterator points to. Returns an iterator to the
+	 * element following it, so that iterating from begin() and continuing
+	 * with the returned iterator visits every other element once.
+	 */
+	iterator erase(iterator entry) {
+		// Check whether we have a valid iterator
+		assert(entry._hashmap == this);
+		assert(entry._idx <= _mask);
+		assert(_distance[entry._idx] != 0);
+		eraseSlot(entry._idx);
+
+		// Iterations start and end at an empty slot, which no cluster
+		// crosses, so a node moved into the erased slot is still unvisited
+		if (_distance[entry._idx] == 0)
+			++entry;
+		return entry;
+	}
+
+	void erase(const Key &key) {
+		const size_type ctr = lookup(key);
+		if (ctr != NONE_FOUND)
+			eraseSlot(ctr);
+	}
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Iterate from an empty slot on, see erase()
+		const size_type start = firstEmpty();
+		for (size_type ctr = (start + 1) & _mask; ctr != start; ctr = (ctr + 1) & _mask) {
+			if (_distance[ctr])
+				return iterator(ctr, start, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator(NONE_FOUND, 0, this);
+	}
+
+	const_iterator	begin() const {
+		// Iterate from an empty slot on, see erase()
+		const size_type start = firstEmpty();
+		for (size_type ctr = (start + 1) & _mask; ctr != start; ctr = (ctr + 1) & _mask) {
+			if (_distance[ctr])
+				return const_iterator(ctr, start, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator(NONE_FOUND, 0, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), firstEmpty(), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), firstEmpty(), this);
+	}
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one. Nodes keep their slots, so no rehashing is needed.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const HM_t &map) {
+	allocStorage(map._mask + 1);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		_distance[ctr] = map._distance[ctr];
+		if (_distance[ctr])
+			new ((void *)&_nodes[ctr]) Node(map._nodes[ctr]);
+	}
+	_size = map._size;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_distance[ctr]) {
+				_nodes[ctr].~Node();
+				_distance[ctr] = 0;
+			}
+		}
+	}
+
+	_size = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::expandStorage(size_type newCapacity) {
+	assert(newCapacity > _mask + 1);
+
+	Node *oldNodes = _nodes;
+	byte *oldDistance = _distance;
+	const size_type oldMask = _mask;
+	const size_type oldSize = _size;
+
+	for (;;) {
+		allocStorage(newCapacity);
+
+		// First place the keys by their distances only, to check that none
+		// of them ends up too far from its home slot, in which case a
+		// larger table is tried.
+		size_type ctr, slot;
+		for (ctr = 0; ctr <= oldMask; ++ctr) {
+			if (oldDistance[ctr] && !makeRoom(homeSlot(oldNodes[ctr]._key), slot, false))
+				break;
+		}
+
+		if (ctr > oldMask)
+			break;
+
+		free(_nodes);
+		free(_distance);
+		newCapacity *= 2;
+	}
+
+	// Now move the old nodes over. Since we know that no key exists
+	// twice in the old table, we don't have to call _equal().
+	memset(_distance, 0, _mask + 1);
+	_size = 0;
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		size_type slot;
+		if (!oldDistance[ctr])
+			continue;
+		makeRoom(homeSlot(oldNodes[ctr]._key), slot, true);
+		moveNode(slot, oldNodes[ctr]);
+		_size++;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	assert(_size == oldSize);
+	(void)oldSize;
+
+	free(oldNodes);
+	free(oldDistance);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	size_type ctr = homeSlot(key);
+
+	// Nodes are ordered by their home slot, so the search can stop as soon
+	// as it meets a node closer to its home slot than the key would be
+	for (size_type distance = 1; distance <= _distance[ctr]; ++distance) {
+		if (_distance[ctr] == distance && _equal(_nodes[ctr]._key, key))
+			return ctr;
+		ctr = (ctr + 1) & _mask;
+	}
+
+	return NONE_FOUND;
+}
+
+/**
+ * Free a slot for a node with the given home slot, by moving the nodes
+ * after it on by one slot. On success, slot is set to the freed slot, which
+ * is marked as used but left for the caller to construct the node in.
+ * Fails if any node would end up too far away from its home slot, in which
+ * case the map is left unchanged. Without moveNodes, only the distances
+ * are updated, for checking whether a table is large enough.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::makeRoom(size_type home, size_type &slot, bool moveNodes) {
+	size_type ctr = home;
+	size_type distance = 1;
+
+	// Skip the nodes which are at least as far from their home slot
+	while (_distance[ctr] >= distance) {
+		ctr = (ctr + 1) & _mask;
+		distance++;
+	}
+	if (distance > FLATHASHMAP_MAX_DISTANCE)
+		return false;
+
+	// Find the end of the cluster; all nodes up to there move one slot on
+	size_type last = ctr;
+	while (_distance[last]) {
+		if (_distance[last] == FLATHASHMAP_MAX_DISTANCE)
+			return false;
+		last = (last + 1) & _mask;
+	}
+
+	while (last != ctr) {
+		const size_type prev = (last - 1) & _mask;
+		if (moveNodes)
+			moveNode(last, _nodes[prev]);
+		_distance[last] = _distance[prev] + 1;
+		last = prev;
+	}
+
+	_distance[ctr] = distance;
+	slot = ctr;
+	return true;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != NONE_FOUND)
+		return ctr;
+
+	// Keep the load factor below a certain threshold.
+	size_type capacity = _mask + 1;
+	if ((_size + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+		expandStorage(capacity < 500 ? (capacity * 4) : (capacity * 2));
+
+	while (!makeRoom(homeSlot(key), ctr, true))
+		expandStorage((_mask + 1) * 2);
+
+	new ((void *)&_nodes[ctr]) Node(key);
+	_size++;
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type ctr) {
+	_nodes[ctr].~Node();
+	_size--;
+
+	// Shift the following nodes of the cluster back by one slot
+	size_type next = (ctr + 1) & _mask;
+	while (_distance[next] > 1) {
+		moveNode(ctr, _nodes[next]);
+		_distance[ctr] = _distance[next] - 1;
+		ctr = next;
+		next = (next + 1) & _mask;
+	}
+
+	_distance[ctr] = 0;
+}
+
+} // End of namespace Common
+
+#endif
@@ -33,7 +33,7 @@ Huffman::Symbol::Symbol(uint32 c, uint32 s) : code(c), symbol(s) {
 }
 
 
-Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const uint8 *lengths, const uint32 *symbols) {
+Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const uint8 *lengths, const uint32 *symbols, uint8 lookupBits) {
 	assert(codeCount > 0);
 
 	assert(codes);
@@ -44,6 +44,7 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 			maxLength = MAX(maxLength, lengths[i]);
 
 	assert(maxLength <= 32);
+	assert(lookupBits <= 16);
 
 	_codes.resize(maxLength);
 	_symbols.resize(codeCount);
@@ -58,6 +59,11 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 		// And put the pointer to the symbol/code struct into the symbol list.
 		_symbols[i] = &_codes[lengths[i] - 1].back();
 	}
+
+	// Don't make the tables wider than the longest code, and make the
+	// secondary tables at most as wide as the primary one
+	_lookupBits = MIN(lookupBits, maxLength);
+	_secondaryBits = MIN<uint8>(maxLength - _lookupBits, _lookupBits);
 }
 
 Huffman::~Huffman() {
@@ -66,6 +72,103 @@ Huffman::~Huffman() {
 void Huffman::setSymbols(const uint32 *symbols) {
 	for (uint32 i = 0; i < _symbols.size(); i++)
 		_symbols[i]->symbol = symbols ? *symbols++ : i;
+
+	// The lookup tables hold the old symbols, rebuild them on next use
+	_lookupTables[0].clear();
+	_lookupTables[1].clear();
+}
+
+/**
+ * Enter a code into all entries of a table whose index starts with it.
+ *
+ * In an MSB2LSB bitstream, the first bit read is the most significant
+ * one of the index, while it's the least significant one in an LSB2MSB
+ * bitstream.
+ */
+static void fillLookupEntries(Array<uint32> &indices, uint32 code, uint32 length, uint32 width, bool msb) {
+	indices.clear();
+
+	for (uint32 rest = 0; rest < (1u << (width - length)); rest++)
+		indices.push_back(msb ? ((code << (width - length)) | rest) : (code | (rest << length)));
+}
+
+void Huffman::buildLookupTable(LookupTable &table, bool msb) const {
+	const uint32 primarySize = 1 << _lookupBits;
+	const uint32 secondarySize = 1 << _secondaryBits;
+
+	table.resize(primarySize);
+	for (uint32 i = 0; i < primarySize; i++) {
+		table[i].symbol = kNoSecondaryTable;
+		table[i].pairSymbol = 0;
+		table[i].length = 0;
+		table[i].pairLength = 0;
+	}
+
+	Array<uint32> indices;
+
+	// Go from the longest to the shortest codes. Like the bitwise search,
+	// this gives shorter codes precedence over longer ones with the same
+	// prefix.
+	for (int length = _codes.size(); length > 0; length--) {
+		for (CodeList::const_iterator cCode = _codes[length - 1].begin(); cCode != _codes[length - 1].end(); ++cCode) {
+			if (length <= _lookupBits) {
+				fillLookupEntries(indices, cCode->code, length, _lookupBits, msb);
+
+				for (uint32 i = 0; i < indices.size(); i++) {
+					table[indices[i]].symbol = cCode->symbol;
+					table[indices[i]].length = length;
+				}
+
+				continue;
+			}
+
+			uint32 restLength = length - _lookupBits;
+			if (restLength > _secondaryBits)
+				continue; // Too long for the tables, leave it to the bitwise search
+
+			// Split the code into the primary table index and the rest
+			uint32 prefix, rest;
+			if (msb) {
+				prefix = cCode->code >> restLength;
+				rest = cCode->code & ((1 << restLength) - 1);
+			} else {
+				prefix = cCode->code & (primarySize - 1);
+				rest = cCode->code >> _lookupBits;
+			}
+
+			if (table[prefix].symbol == kNoSecondaryTable) {
+				table[prefix].symbol = table.size();
+				table.resize(table.size() + secondarySize);
+			}
+
+			uint32 offset = table[prefix].symbol;
+			fillLookupEntries(indices, rest, restLength, _secondaryBits, msb);
+
+			for (uint32 i = 0; i < indices.size(); i++) {
+				LookupEntry &entry = table[offset + indices[i]];
+				entry.symbol = cCode->symbol;
+				entry.pairSymbol = 0;
+				entry.length = length;
+				entry.pairLength = 0;
+			}
+		}
+	}
+
+	// Find the primary entries in which the first code is directly
+	// followed by a second complete code
+	for (uint32 i = 0; i < primarySize; i++) {
+		uint32 length = table[i].length;
+		if (length == 0 || length == _lookupBits)
+			continue;
+
+		uint32 next = msb ? ((i << length) & (primarySize - 1)) : (i >> length);
+
+		const LookupEntry &nextEntry = table[next];
+		if (nextEntry.length != 0 && nextEntry.length <= _lookupBits - length) {
+			table[i].pairSymbol = nextEntry.symbol;
+			table[i].pairLength = length + nextEntry.length;
+		}
+	}
 }
 
 } // End of namespace Common
@@ -27,18 +27,27 @@
 
 #include "common/array.h"
 #include "common/list.h"
+#include "common/textconsole.h"
 #include "common/types.h"
+#include "common/util.h"
 
 namespace Common {
 
 /**
  * Huffman bitstream decoding
  *
+ * Codes no longer than the lookup width are decoded with a single table
+ * lookup. Longer codes go through secondary tables, and only codes which
+ * fit into neither are searched for bit by bit.
+ *
  * Used in engines:
  *  - scumm
  */
 class Huffman {
 public:
+	/** The default width of the primary lookup table, in bits. */
+	static const uint8 kDefaultLookupBits = 9;
+
 	/** Construct a Huffman decoder.
 	 *
 	 *  @param maxLength Maximal code length. If 0, it's searched for.
@@ -46,8 +55,9 @@ public:
 	 *  @param codes The actual codes.
 	 *  @param lengths Lengths of the individual codes.
 	 *  @param symbols The symbols. If 0, assume they are identical to the code indices.
+	 *  @param lookupBits Width of the primary lookup table. If 0, codes are only searched for bit by bit.
 	 */
-	Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const uint8 *lengths, const uint32 *symbols = 0);
+	Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const uint8 *lengths, const uint32 *symbols = 0, uint8 lookupBits = kDefaultLookupBits);
 	~Huffman();
 
 	/** Modify the codes' symbols. */
@@ -56,18 +66,88 @@ public:
 	/** Return the next symbol in the bitstream. */
 	template<class BITSTREAM>
 	uint32 getSymbol(BITSTREAM &bits) const {
-		uint32 code = 0;
+		if (_lookupBits == 0)
+			return getSymbolBitwise(bits);
+
+		const bool msb = BITSTREAM::isMSB2LSBOrder();
+		const LookupTable &table = getLookupTable(msb);
+
+		// Short codes can often be decoded from the bits the bitstream has
+		// buffered already, without reading ahead in its stream
+		uint8 buffered = _lookupBits;
+		uint32 index = bits.peekBufferedBits(buffered);
+		if (buffered != 0 && buffered < _lookupBits) {
+			const LookupEntry &entry = table[msb ? (index << (_lookupBits - buffered)) : index];
+			if (entry.length != 0 && entry.length <= buffered) {
+				bits.skip(entry.length);
+				return entry.symbol;
+			}
+		}
 
-		for (uint32 i = 0; i < _codes.size(); i++) {
-			bits.addBit(code, i);
+		uint32 available = MIN<uint32>(bits.size() - bits.pos(), _lookupBits);
+		const LookupEntry &entry = table[peekIndex(bits, available, _lookupBits, msb)];
 
-			for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-				if (code == cCode->code)
-					return cCode->symbol;
+		if (entry.length != 0 && entry.length <= available) {
+			bits.skip(entry.length);
+			return entry.symbol;
 		}
 
-		error("Unknown Huffman code");
-		return 0;
+		if (entry.length == 0 && entry.symbol != kNoSecondaryTable) {
+			uint32 totalBits = _lookupBits + _secondaryBits;
+			available = MIN<uint32>(bits.size() - bits.pos(), totalBits);
+
+			uint32 index = peekIndex(bits, available, totalBits, msb);
+			index = msb ? (index & ((1 << _secondaryBits) - 1)) : (index >> _lookupBits);
+
+			const LookupEntry &secondary = table[entry.symbol + index];
+			if (secondary.length != 0 && secondary.length <= available) {
+				bits.skip(secondary.length);
+				return secondary.symbol;
+			}
+		}
+
+		return getSymbolBitwise(bits);
+	}
+
+	/**
+	 * Decode several symbols from the bitstream at once.
+	 *
+	 * Where two short codes fit into a single table lookup, both of
+	 * them are decoded by that lookup.
+	 *
+	 * @param bits The bitstream to read from.
+	 * @param symbols Buffer which receives the decoded symbols.
+	 * @param count Number of symbols to decode.
+	 */
+	template<class BITSTREAM>
+	void getSymbols(BITSTREAM &bits, uint32 *symbols, uint32 count) const {
+		if (_lookupBits == 0) {
+			while (count-- > 0)
+				*symbols++ = getSymbolBitwise(bits);
+			return;
+		}
+
+		const bool msb = BITSTREAM::isMSB2LSBOrder();
+		const LookupTable &table = getLookupTable(msb);
+
+		while (count > 0) {
+			uint32 available = MIN<uint32>(bits.size() - bits.pos(), _lookupBits);
+			const LookupEntry &entry = table[peekIndex(bits, available, _lookupBits, msb)];
+
+			if (count >= 2 && entry.pairLength != 0 && entry.pairLength <= available) {
+				bits.skip(entry.pairLength);
+				*symbols++ = entry.symbol;
+				*symbols++ = entry.pairSymbol;
+				count -= 2;
+			} else if (entry.length != 0 && entry.length <= available) {
+				bits.skip(entry.length);
+				*symbols++ = entry.symbol;
+				count--;
+			} else {
+				*symbols++ = getSymbol(bits);
+				count--;
+			}
+		}
 	}
 
 private:
@@ -82,11 +162,74 @@ private:
 	typedef Array<CodeList> CodeLists;
 	typedef Array<Symbol *> SymbolList;
 
+	/** Marks primary lookup entries without a secondary table. */
+	static const uint32 kNoSecondaryTable = 0xFFFFFFFF;
+
+	struct LookupEntry {
+		/** The symbol, or the offset of the secondary table if length is 0. */
+		uint32 symbol;
+		/** The symbol of a second code following in the same lookup. */
+		uint32 pairSymbol;
+		/** Length of the code, 0 if no code is fully contained in the lookup. */
+		uint8 length;
+		/** Combined length of both codes, 0 if there is no second code. */
+		uint8 pairLength;
+	};
+
+	typedef Array<LookupEntry> LookupTable;
+
 	/** Lists of codes and their symbols, sorted by code length. */
 	CodeLists _codes;
 
 	/** Sorted list of pointers to the symbols. */
 	SymbolList _symbols;
+
+	/** Width of the primary and secondary lookup tables. */
+	uint8 _lookupBits, _secondaryBits;
+
+	/**
+	 * Lookup tables for MSB2LSB and LSB2MSB bitstreams, built on first use.
+	 * A primary table is followed by the secondary tables it refers to.
+	 */
+	mutable LookupTable _lookupTables[2];
+
+	const LookupTable &getLookupTable(bool msb) const {
+		LookupTable &table = _lookupTables[msb ? 1 : 0];
+		if (table.empty())
+			buildLookupTable(table, msb);
+
+		return table;
+	}
+
+	void buildLookupTable(LookupTable &table, bool msb) const;
+
+	/**
+	 * Peek the next bits as an index into a table of the given width.
+	 * Near the end of the stream, fewer bits are available and the
+	 * missing ones are treated as zero.
+	 */
+	template<class BITSTREAM>
+	static uint32 peekIndex(BITSTREAM &bits, uint32 available, uint32 width, bool msb) {
+		uint32 index = bits.peekBits(available);
+		return msb ? (index << (width - available)) : index;
+	}
+
+	/** Search for the next symbol bit by bit. */
+	template<class BITSTREAM>
+	uint32 getSymbolBitwise(BITSTREAM &bits) const {
+		uint32 code = 0;
+
+		for (uint32 i = 0; i < _codes.size(); i++) {
+			bits.addBit(code, i);
+
+			for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
+				if (code == cCode->code)
+					return cCode->symbol;
+		}
+
+		error("Unknown Huffman code");
+		return 0;
+	}
 };
 
 } // End of namespace Common
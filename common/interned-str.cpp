@@ -0,0 +1,93 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/interned-str.h"
+
+namespace Common {
+
+namespace {
+
+/**
+ * The atom table. It is created on first use, so that interned strings
+ * can safely be constructed during static initialization, and frees all
+ * its entries on exit.
+ */
+class AtomTable {
+	typedef HashMap<String, InternedString::Entry *, IgnoreCase_Hash, IgnoreCase_EqualTo> EntryMap;
+	EntryMap _entries;
+
+public:
+	InternedString::Entry _empty;
+
+	AtomTable() : _empty(String()) {}
+
+	~AtomTable() {
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+			delete i->_value;
+	}
+
+	const InternedString::Entry *intern(const String &name) {
+		if (name.empty())
+			return &_empty;
+
+		InternedString::Entry *&entry = _entries[name];
+		if (!entry)
+			entry = new InternedString::Entry(name);
+		return entry;
+	}
+
+	const InternedString::Entry *find(const String &name) const {
+		EntryMap::const_iterator i = _entries.find(name);
+		if (i == _entries.end())
+			return &_empty;
+		return i->_value;
+	}
+
+	uint size() const {
+		return _entries.size();
+	}
+};
+
+AtomTable &getAtomTable() {
+	static AtomTable table;
+	return table;
+}
+
+} // End of anonymous namespace
+
+const InternedString::Entry *InternedString::intern(const String &name) {
+	return getAtomTable().intern(name);
+}
+
+const InternedString::Entry *InternedString::find(const String &name) {
+	return getAtomTable().find(name);
+}
+
+const InternedString::Entry *InternedString::emptyEntry() {
+	return &getAtomTable()._empty;
+}
+
+uint InternedString::getTableSize() {
+	return getAtomTable().size();
+}
+
+} // End of namespace Common
@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_INTERNED_STR_H
+#define COMMON_INTERNED_STR_H
+
+#include "common/hash-str.h"
+
+namespace Common {
+
+/**
+ * An interned, case insensitive string. Every distinct name (ignoring case)
+ * is stored exactly once in a global atom table, together with its
+ * precomputed hash. InternedString itself is just a pointer to the table
+ * entry, so copying is cheap, hashing needs no string traversal and
+ * comparing two interned strings is a pointer compare.
+ *
+ * This is intended for keys which are looked up over and over again, like
+ * file names and engine symbol names. Interning a name costs one lookup in
+ * the atom table; after that all lookups keyed by the InternedString are
+ * cheap. Since atoms are never freed, do not intern arbitrary user input.
+ *
+ * The atom table is not guarded by a mutex, so names must only be interned
+ * or looked up from the main thread. Comparing and hashing InternedStrings
+ * which already exist is safe from any thread.
+ *
+ * The table stores the lowercase form of each name, so toString() returns
+ * the same spelling however the name was interned, and in whichever order.
+ */
+class InternedString {
+public:
+	struct Entry {
+		String _name;
+		uint _hash;
+
+		Entry(const String &name) : _name(name), _hash(hashit_lower(name)) { _name.toLowercase(); }
+	};
+
+private:
+	const Entry *_entry;
+
+	static const Entry *intern(const String &name);
+	static const Entry *find(const String &name);
+	static const Entry *emptyEntry();
+
+	explicit InternedString(const Entry *entry) : _entry(entry) {}
+
+public:
+	/** Construct the interned empty string. */
+	InternedString() : _entry(emptyEntry()) {}
+
+	/** Intern the given name, adding it to the atom table if necessary. */
+	explicit InternedString(const String &name) : _entry(intern(name)) {}
+	explicit InternedString(const char *name) : _entry(intern(name)) {}
+
+	/**
+	 * Return the interned version of the name if it has already been
+	 * interned, or the empty string otherwise. Unlike the constructor,
+	 * this never grows the atom table.
+	 */
+	static InternedString lookup(const String &name) { return InternedString(find(name)); }
+
+	/** Return the name in lowercase. */
+	const String &toString() const { return _entry->_name; }
+	const char *c_str() const { return _entry->_name.c_str(); }
+	uint hash() const { return _entry->_hash; }
+	bool empty() const { return _entry->_name.empty(); }
+
+	bool operator==(const InternedString &x) const { return _entry == x._entry; }
+	bool operator!=(const InternedString &x) const { return _entry != x._entry; }
+
+	/** Return the number of names in the atom table. */
+	static uint getTableSize();
+};
+
+// Specalization of the Hash functor for InternedString objects. The hash
+// matches IgnoreCase_Hash for the same name.
+template<>
+struct Hash<InternedString> {
+	uint operator()(const InternedString &s) const {
+		return s.hash();
+	}
+};
+
+} // End of namespace Common
+
+#endif
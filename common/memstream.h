@@ -71,6 +71,11 @@ public:
 	int32 size() const { return _size; }
 
 	bool seek(int32 offs, int whence = SEEK_SET);
+	const byte *borrowData(uint32 dataSize);
+	bool hasDataInMemory() const { return true; }
+
+	/** Return the wrapped buffer, so that it can be accessed without copying. */
+	const byte *getData() const { return _ptrOrig; }
 };
 
 
@@ -15,6 +15,7 @@ MODULE_OBJS := \
 	hashmap.o \
 	iff_container.o \
 	ini-file.o \
+	interned-str.o \
 	installshield_cab.o \
 	json.o \
 	language.o \
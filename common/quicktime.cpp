@@ -254,7 +254,20 @@ int QuickTimeParser::readLeaf(Atom atom) {
 }
 
 int QuickTimeParser::readMOOV(Atom atom) {
-	if (readDefault(atom) < 0)
+	// Read the whole 'moov' atom with a single read and parse it from
+	// memory. It holds the sample tables, which would otherwise go
+	// through the file stream one table entry at a time.
+	SeekableReadStream *oldStream = _fd;
+	_fd = oldStream->readStream(atom.size);
+
+	Atom a = { MKTAG('m', 'o', 'o', 'v'), 0, atom.size };
+	int err = readDefault(a);
+
+	// Assign the file handle back to the original handle
+	delete _fd;
+	_fd = oldStream;
+
+	if (err < 0)
 		return -1;
 
 	// We parsed the 'moov' atom, so we don't need anything else
@@ -25,6 +25,7 @@
 
 #include "common/file.h"
 #include "common/memstream.h"
+#include "common/noncopyable.h"
 #include "common/safe-bool.h"
 #include "common/scummsys.h"
 #include "common/type-traits.h"
@@ -1019,6 +1020,47 @@ public:
 	inline reference operator[](const index_type index) { return _span[index]; }
 };
 
+#pragma mark -
+#pragma mark StreamSpan
+
+/**
+ * Read-only Span over the next bytes of a stream, which advances the stream
+ * past them. The data is borrowed without copying from streams which
+ * support SeekableReadStream::borrowData(), and read into memory owned by
+ * the StreamSpan otherwise. Either way it stays valid as long as both the
+ * StreamSpan and the stream exist, and the stream is not read from or
+ * seeked in the meantime.
+ *
+ * If the stream ends early, the span only covers the bytes actually read.
+ */
+class StreamSpan : NonCopyable {
+public:
+	inline StreamSpan(SeekableReadStream &stream, const uint32 size) : _owned(nullptr) {
+		const byte *data = stream.borrowData(size);
+		uint32 dataSize = size;
+		if (!data) {
+			_owned = new byte[size];
+			dataSize = stream.read(_owned, size);
+			data = _owned;
+		}
+		_span = Span<const byte>(data, dataSize);
+	}
+
+	inline ~StreamSpan() {
+		delete[] _owned;
+	}
+
+	/** Whether the data is borrowed from the stream rather than copied. */
+	inline bool isBorrowed() const { return _owned == nullptr; }
+
+	inline const Span<const byte> &operator*() const { return _span; }
+	inline const Span<const byte> *operator->() const { return &_span; }
+
+private:
+	Span<const byte> _span;
+	byte *_owned;
+};
+
 } // End of namespace Common
 
 #endif
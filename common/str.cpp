@@ -393,6 +393,30 @@ void String::clear() {
 	_storage[0] = 0;
 }
 
+void String::swap(String &str) {
+	if (&str == this)
+		return;
+
+	const bool intern = isStorageIntern();
+	const bool strIntern = str.isStorageIntern();
+
+	// Exchanging the union swaps either the builtin characters or the
+	// refcount and capacity of the heap storage
+	char tmp[_builtinCapacity];
+	memcpy(tmp, _storage, _builtinCapacity);
+	memcpy(_storage, str._storage, _builtinCapacity);
+	memcpy(str._storage, tmp, _builtinCapacity);
+
+	SWAP(_size, str._size);
+	SWAP(_str, str._str);
+
+	// Builtin storage has to be pointed to at its new location
+	if (strIntern)
+		_str = _storage;
+	if (intern)
+		str._str = str._storage;
+}
+
 void String::setChar(char c, uint32 p) {
 	assert(p < _size);
 
@@ -223,6 +223,9 @@ public:
 	/** Clears the string, making it empty. */
 	void clear();
 
+	/** Exchange the contents with another string, without copying any heap storage. */
+	void swap(String &str);
+
 	/** Convert all characters in the string to lowercase. */
 	void toLowercase();
 
@@ -476,6 +479,9 @@ size_t strnlen(const char *src, size_t maxSize);
 
 } // End of namespace Common
 
+/** Overload of SWAP which swaps the string contents instead of copying them. */
+inline void SWAP(Common::String &a, Common::String &b) { a.swap(b); }
+
 extern int scumm_stricmp(const char *s1, const char *s2);
 extern int scumm_strnicmp(const char *s1, const char *s2, uint n);
 
@@ -75,6 +75,17 @@ uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+const byte *MemoryReadStream::borrowData(uint32 dataSize) {
+	if (dataSize > _size - _pos)
+		return 0;
+
+	const byte *data = _ptr;
+	_ptr += dataSize;
+	_pos += dataSize;
+
+	return data;
+}
+
 bool MemoryReadStream::seek(int32 offs, int whence) {
 	// Pre-Condition
 	assert(_pos <= _size);
@@ -261,6 +272,19 @@ bool SeekableSubReadStream::seek(int32 offset, int whence) {
 	return ret;
 }
 
+const byte *SeekableSubReadStream::borrowData(uint32 dataSize) {
+	if (dataSize > _end - _pos)
+		return 0;
+
+	// Make sure the parent stream is at the right position
+	_parentStream->seek(_pos);
+	const byte *data = _parentStream->borrowData(dataSize);
+	if (data)
+		_pos += dataSize;
+
+	return data;
+}
+
 uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Make sure the parent stream is at the right position
 	seek(0, SEEK_CUR);
@@ -466,6 +490,162 @@ SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStr
 
 namespace {
 
+/**
+ * Wrapper class which reads ahead of the position in a SeekableReadStream,
+ * with a read size adapting to the access pattern.
+ * @see wrapReadAheadSeekableReadStream
+ */
+class ReadAheadSeekableReadStream : public SeekableReadStream {
+protected:
+	enum {
+		kMinReadAhead = 4096
+	};
+
+	DisposablePtr<SeekableReadStream> _parentStream;
+	byte *_buf;
+	const uint32 _maxReadAhead;
+	uint32 _readAhead;	///< size of the next read from the parent stream
+	int32 _bufStart;	///< position of the buffer start in the parent stream
+	uint32 _bufSize;	///< number of valid bytes in the buffer
+	uint32 _pos;		///< current position inside the buffer
+	bool _eos;
+
+	/** Read from the parent stream, starting right after the buffer. */
+	uint32 readFromParent(void *dataPtr, uint32 dataSize);
+
+public:
+	ReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxReadAhead, DisposeAfterUse::Flag disposeParentStream);
+	virtual ~ReadAheadSeekableReadStream();
+
+	virtual bool eos() const { return _eos; }
+	virtual bool err() const { return _parentStream->err(); }
+	virtual void clearErr() { _eos = false; _parentStream->clearErr(); }
+
+	virtual uint32 read(void *dataPtr, uint32 dataSize);
+	virtual const byte *borrowData(uint32 dataSize);
+
+	virtual int32 pos() const { return _bufStart + _pos; }
+	virtual int32 size() const { return _parentStream->size(); }
+	virtual bool seek(int32 offset, int whence = SEEK_SET);
+};
+
+ReadAheadSeekableReadStream::ReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxReadAhead, DisposeAfterUse::Flag disposeParentStream)
+	: _parentStream(parentStream, disposeParentStream),
+	_maxReadAhead(MAX<uint32>(maxReadAhead, kMinReadAhead)),
+	_readAhead(kMinReadAhead),
+	_bufStart(parentStream->pos()),
+	_bufSize(0),
+	_pos(0),
+	_eos(false) {
+
+	_buf = new byte[_maxReadAhead];
+}
+
+ReadAheadSeekableReadStream::~ReadAheadSeekableReadStream() {
+	delete[] _buf;
+}
+
+uint32 ReadAheadSeekableReadStream::readFromParent(void *dataPtr, uint32 dataSize) {
+	_bufStart += _bufSize;
+	_bufSize = _pos = 0;
+
+	const uint32 n = _parentStream->read(dataPtr, dataSize);
+	if (dataPtr == _buf)
+		_bufSize = n;
+	else
+		_bufStart += n;
+
+	// The buffer was used up, so the data is read sequentially
+	_readAhead = MIN(_readAhead * 2, _maxReadAhead);
+	return n;
+}
+
+uint32 ReadAheadSeekableReadStream::read(void *dataPtr, uint32 dataSize) {
+	uint32 alreadyRead = MIN(dataSize, _bufSize - _pos);
+	memcpy(dataPtr, _buf + _pos, alreadyRead);
+	_pos += alreadyRead;
+
+	if (alreadyRead == dataSize)
+		return alreadyRead;
+
+	dataPtr = (byte *)dataPtr + alreadyRead;
+	dataSize -= alreadyRead;
+
+	// Large requests go to the parent stream directly
+	if (dataSize >= _readAhead) {
+		const uint32 n = readFromParent(dataPtr, dataSize);
+		if (n < dataSize)
+			_eos = true;
+		return alreadyRead + n;
+	}
+
+	readFromParent(_buf, _readAhead);
+	if (_bufSize < dataSize) {
+		_eos = true;
+		dataSize = _bufSize;
+	}
+
+	memcpy(dataPtr, _buf, dataSize);
+	_pos = dataSize;
+	return alreadyRead + dataSize;
+}
+
+const byte *ReadAheadSeekableReadStream::borrowData(uint32 dataSize) {
+	// Only data already read ahead can be lent out. The next read may
+	// refill the buffer, which is allowed by the borrowData() contract.
+	if (dataSize > _bufSize - _pos)
+		return 0;
+
+	const byte *data = _buf + _pos;
+	_pos += dataSize;
+	return data;
+}
+
+bool ReadAheadSeekableReadStream::seek(int32 offset, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offset = size() + offset;
+		break;
+	case SEEK_CUR:
+		offset = pos() + offset;
+		break;
+	default:
+		break;
+	}
+
+	_eos = false;	// seeking always cancels EOS
+
+	if (offset >= _bufStart && offset <= _bufStart + (int32)_bufSize) {
+		// Still inside the data read so far
+		_pos = offset - _bufStart;
+		return true;
+	}
+
+	// A jump elsewhere: start over with small reads, so that seek heavy
+	// access patterns do not read much data in vain
+	_readAhead = kMinReadAhead;
+	_bufStart = offset;
+	_bufSize = _pos = 0;
+	return _parentStream->seek(offset);
+}
+
+} // End of anonymous namespace
+
+SeekableReadStream *wrapReadAheadSeekableReadStream(SeekableReadStream *parentStream, uint32 maxReadAhead, DisposeAfterUse::Flag disposeParentStream) {
+	if (!parentStream)
+		return 0;
+
+	// A stream with all of its data in memory gains nothing from reading ahead
+	if (disposeParentStream == DisposeAfterUse::YES && parentStream->hasDataInMemory())
+		return parentStream;
+
+	return new ReadAheadSeekableReadStream(parentStream, maxReadAhead, disposeParentStream);
+}
+
+#pragma mark -
+
+namespace {
+
 /**
  * Wrapper class which adds buffering to any WriteStream.
  */
@@ -511,6 +511,33 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Lend out the next dataSize bytes of the stream without copying them,
+	 * and advance the stream position past them. The data belongs to the
+	 * stream. It stays valid until the stream is destroyed or modified, or,
+	 * for streams lending out data from an internal buffer, until the next
+	 * read or seek.
+	 *
+	 * Only streams which have the data in memory support this. All other
+	 * streams, or a request for more bytes than are available, return 0 and
+	 * leave the position unchanged; the caller then has to read() the data.
+	 *
+	 * @see Common::StreamSpan for a wrapper which falls back to copying
+	 *
+	 * @param dataSize	the number of bytes to borrow
+	 * @return a pointer to the data, or 0 if it cannot be borrowed
+	 */
+	virtual const byte *borrowData(uint32 dataSize) { return 0; }
+
+	/**
+	 * Check whether all the data of the stream is kept in memory, so that
+	 * borrowData() succeeds for any part of it. Streams which only buffer
+	 * part of their data return false, even if they lend out that part.
+	 *
+	 * @return true if all the data is in memory
+	 */
+	virtual bool hasDataInMemory() const { return false; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
@@ -106,6 +106,8 @@ typedef struct {
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/substream.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -517,6 +519,45 @@ static uLong unzlocal_SearchCentralDir(Common::SeekableReadStream &fin) {
 	return uPosFound;
 }
 
+/*
+  Memory copy of the central directory which keeps reporting positions
+  relative to the zipfile, so the header parsing code can use it in place
+  of the real stream while the member index is built.
+*/
+class ZipCentralDirStream : public Common::MemoryReadStream {
+public:
+	ZipCentralDirStream(const byte *data, uint32 size, int32 base) :
+		Common::MemoryReadStream(data, size, DisposeAfterUse::YES), _base(base), _outOfRange(false) {}
+
+	int32 pos() const { return Common::MemoryReadStream::pos() + _base; }
+	int32 size() const { return Common::MemoryReadStream::size() + _base; }
+	bool eos() const { return _outOfRange || Common::MemoryReadStream::eos(); }
+
+	bool seek(int32 offs, int whence = SEEK_SET) {
+		// The offsets are taken from the archive, so they may point
+		// anywhere in a broken one
+		int64 target = offs;
+		if (whence == SEEK_CUR)
+			target += pos();
+		else if (whence == SEEK_END)
+			target += size();
+
+		if (target < _base || target > size()) {
+			// Fail like at the end of the data
+			Common::MemoryReadStream::seek(0, SEEK_END);
+			_outOfRange = true;
+			return false;
+		}
+
+		_outOfRange = false;
+		return Common::MemoryReadStream::seek((int32)(target - _base), SEEK_SET);
+	}
+
+private:
+	int32 _base;
+	bool _outOfRange;
+};
+
 /*
   Open a Zip file. path contain the full pathname (by example,
      on a Windows NT computer "c:\\test\\zlib109.zip" or on an Unix computer
@@ -605,6 +646,21 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	us->central_pos = central_pos;
 	us->pfile_in_zip_read = NULL;
 
+	// Build the member index from a single read of the central directory
+	// instead of seeking and reading every header field from the file.
+	Common::SeekableReadStream *centralDir = NULL;
+	const uLong centralDirStart = us->offset_central_dir + us->byte_before_the_zipfile;
+	byte *centralDirData = (byte *)malloc(us->size_central_dir);
+	if (centralDirData) {
+		us->_stream->seek(centralDirStart, SEEK_SET);
+		if (us->_stream->read(centralDirData, us->size_central_dir) == us->size_central_dir) {
+			centralDir = new ZipCentralDirStream(centralDirData, us->size_central_dir, centralDirStart);
+			us->_stream = centralDir;
+		} else {
+			free(centralDirData);
+		}
+	}
+
 	err = unzGoToFirstFile((unzFile)us);
 
 	while (err == UNZ_OK) {
@@ -626,6 +682,11 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		// Move to the next file
 		err = unzGoToNextFile((unzFile)us);
 	}
+
+	if (centralDir) {
+		us->_stream = stream;
+		delete centralDir;
+	}
 	return (unzFile)us;
 }
 
@@ -1419,12 +1480,232 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 
 namespace Common {
 
+enum {
+	/** Members at least this large are read from the archive on demand. */
+	kZipStreamingThreshold = 256 * 1024
+};
+
+#ifdef USE_ZLIB
+
+/**
+ * A stream for a deflated member, which inflates the data from the
+ * archive as it is read. Every member stream has its own handle to the
+ * archive, zlib state and position, so several members can be read at
+ * the same time, also from different threads.
+ *
+ * While reading forward, a copy of the inflate state is kept every
+ * kCheckpointInterval bytes. Seeking backwards resumes from the closest
+ * of these checkpoints instead of from the start of the member.
+ */
+class ZipInflateStream : public SeekableReadStream {
+public:
+	ZipInflateStream(SeekableReadStream *archiveStream, uint32 dataOffset, uint32 compressedSize, uint32 uncompressedSize, uint32 crc);
+	~ZipInflateStream();
+
+	bool err() const { return _err; }
+	void clearErr() { _err = false; _eos = false; }
+	bool eos() const { return _eos; }
+
+	uint32 read(void *dataPtr, uint32 dataSize);
+
+	int32 pos() const { return _pos; }
+	int32 size() const { return _size; }
+	bool seek(int32 offset, int whence = SEEK_SET);
+
+private:
+	enum {
+		kBufferSize = 16384,
+		kCheckpointInterval = 256 * 1024
+	};
+
+	struct Checkpoint {
+		uint32 compressedPos;
+		z_stream stream;
+	};
+
+	ScopedPtr<SeekableReadStream> _archiveStream;
+	uint32 _dataOffset;
+	uint32 _compressedSize;
+	uint32 _size;
+	uint32 _crc;
+
+	z_stream _stream;
+	byte _buffer[kBufferSize];
+	uint32 _compressedPos;
+	uint32 _pos;
+	bool _eos;
+	bool _err;
+
+	/**
+	 * Checkpoint i holds the inflate state at (i + 1) * kCheckpointInterval.
+	 * They are kept by pointer, as zlib doesn't allow moving a z_stream.
+	 */
+	Array<Checkpoint *> _checkpoints;
+
+	/** The CRC of the data up to _crcPos, only advanced by sequential reads. */
+	uLong _crcData;
+	uint32 _crcPos;
+
+	uint32 inflateData(byte *dst, uint32 len);
+	void restartAt(uint32 checkpoint);
+};
+
+ZipInflateStream::ZipInflateStream(SeekableReadStream *archiveStream, uint32 dataOffset, uint32 compressedSize, uint32 uncompressedSize, uint32 crc)
+	: _archiveStream(archiveStream), _dataOffset(dataOffset), _compressedSize(compressedSize), _size(uncompressedSize), _crc(crc),
+	  _stream(), _compressedPos(0), _pos(0), _eos(false), _err(false), _crcData(0), _crcPos(0) {
+	// There is no zlib header in zip archives
+	_err = inflateInit2(&_stream, -MAX_WBITS) != Z_OK;
+	_stream.next_in = _buffer;
+	_stream.avail_in = 0;
+}
+
+ZipInflateStream::~ZipInflateStream() {
+	for (uint i = 0; i < _checkpoints.size(); i++) {
+		inflateEnd(&_checkpoints[i]->stream);
+		delete _checkpoints[i];
+	}
+
+	inflateEnd(&_stream);
+}
+
+uint32 ZipInflateStream::inflateData(byte *dst, uint32 len) {
+	_stream.next_out = dst;
+	_stream.avail_out = len;
+
+	while (_stream.avail_out > 0) {
+		if (_stream.avail_in == 0) {
+			uint32 readSize = MIN<uint32>(kBufferSize, _compressedSize - _compressedPos);
+
+			// Like unzip, don't wait for Z_STREAM_END, the sizes are known
+			if (readSize == 0)
+				break;
+
+			_archiveStream->seek(_dataOffset + _compressedPos, SEEK_SET);
+			if (_archiveStream->read(_buffer, readSize) != readSize) {
+				_err = true;
+				break;
+			}
+
+			_compressedPos += readSize;
+			_stream.next_in = _buffer;
+			_stream.avail_in = readSize;
+		}
+
+		int zlibErr = inflate(&_stream, Z_SYNC_FLUSH);
+		if (zlibErr == Z_STREAM_END)
+			break;
+
+		if (zlibErr != Z_OK) {
+			_err = true;
+			break;
+		}
+	}
+
+	return len - _stream.avail_out;
+}
+
+void ZipInflateStream::restartAt(uint32 checkpoint) {
+	inflateEnd(&_stream);
+
+	if (checkpoint == 0) {
+		_err = inflateInit2(&_stream, -MAX_WBITS) != Z_OK;
+		_compressedPos = 0;
+		_pos = 0;
+	} else {
+		_err = inflateCopy(&_stream, &_checkpoints[checkpoint - 1]->stream) != Z_OK;
+		_compressedPos = _checkpoints[checkpoint - 1]->compressedPos;
+		_pos = checkpoint * kCheckpointInterval;
+	}
+
+	_stream.next_in = _buffer;
+	_stream.avail_in = 0;
+}
+
+uint32 ZipInflateStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 total = 0;
+
+	while (total < dataSize && !_err) {
+		if (_pos == _size) {
+			_eos = true;
+			break;
+		}
+
+		uint32 nextCheckpoint = (_checkpoints.size() + 1) * kCheckpointInterval;
+		uint32 len = MIN(dataSize - total, _size - _pos);
+
+		// Stop at the next checkpoint position, if it hasn't been saved yet
+		if (_pos < nextCheckpoint)
+			len = MIN(len, nextCheckpoint - _pos);
+
+		uint32 inflated = inflateData(dst + total, len);
+		if (inflated == 0) {
+			_err = true;
+			break;
+		}
+
+		if (_crcPos == _pos) {
+			_crcData = crc32(_crcData, dst + total, inflated);
+			_crcPos += inflated;
+
+			if (_crcPos == _size && _crcData != _crc)
+				warning("ZipInflateStream: CRC mismatch");
+		}
+
+		total += inflated;
+		_pos += inflated;
+
+		if (_pos == nextCheckpoint) {
+			Checkpoint *checkpoint = new Checkpoint();
+			checkpoint->compressedPos = _compressedPos - _stream.avail_in;
+			if (inflateCopy(&checkpoint->stream, &_stream) == Z_OK)
+				_checkpoints.push_back(checkpoint);
+			else
+				delete checkpoint;
+		}
+	}
+
+	return total;
+}
+
+bool ZipInflateStream::seek(int32 offset, int whence) {
+	int32 newPos = offset;
+	if (whence == SEEK_CUR)
+		newPos = _pos + offset;
+	else if (whence == SEEK_END)
+		newPos = _size + offset;
+
+	if (newPos < 0 || (uint32)newPos > _size)
+		return false;
+
+	// Resume from the closest checkpoint when seeking backwards, or when
+	// one closer to the target is available
+	uint32 checkpoint = MIN<uint32>(newPos / kCheckpointInterval, _checkpoints.size());
+	if ((uint32)newPos < _pos || checkpoint * kCheckpointInterval > _pos)
+		restartAt(checkpoint);
+
+	byte skipBuffer[1024];
+	while (!_err && _pos < (uint32)newPos)
+		read(skipBuffer, MIN<uint32>(sizeof(skipBuffer), newPos - _pos));
+
+	_eos = false;
+	return !_err;
+}
+
+#endif // USE_ZLIB
 
 class ZipArchive : public Archive {
 	unzFile _zipFile;
 
+	/**
+	 * Where the archive can be opened again from, to give every streamed
+	 * member a file handle of its own. When the archive was created from
+	 * a stream, this is not set and all members are read into memory.
+	 */
+	ArchiveMemberPtr _source;
+
 public:
-	ZipArchive(unzFile zipFile);
+	ZipArchive(unzFile zipFile, const ArchiveMemberPtr &source);
 
 
 	~ZipArchive();
@@ -1433,6 +1714,9 @@ public:
 	virtual int listMembers(ArchiveMemberList &list) const;
 	virtual const ArchiveMemberPtr getMember(const String &name) const;
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+private:
+	SeekableReadStream *createStreamingReadStream(unz_s *archive) const;
 };
 
 /*
@@ -1453,7 +1737,7 @@ public:
 };
 */
 
-ZipArchive::ZipArchive(unzFile zipFile) : _zipFile(zipFile) {
+ZipArchive::ZipArchive(unzFile zipFile, const ArchiveMemberPtr &source) : _zipFile(zipFile), _source(source) {
 	assert(_zipFile);
 }
 
@@ -1462,7 +1746,10 @@ ZipArchive::~ZipArchive() {
 }
 
 bool ZipArchive::hasFile(const String &name) const {
-	return (unzLocateFile(_zipFile, name.c_str(), 2) == UNZ_OK);
+	// Only consult the member index; unzLocateFile() would also make the
+	// member current, which is not needed for an existence check.
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	return archive->_hash.contains(name);
 }
 
 int ZipArchive::listMembers(ArchiveMemberList &list) const {
@@ -1489,6 +1776,15 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	if (unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
 		return 0;
 
+	// Read large members from the archive as they are accessed, instead
+	// of inflating them into memory as a whole
+	unz_s *archive = (unz_s *)_zipFile;
+	if (_source && archive->cur_file_info.uncompressed_size >= kZipStreamingThreshold) {
+		SeekableReadStream *stream = createStreamingReadStream(archive);
+		if (stream)
+			return stream;
+	}
+
 	unz_file_info fileInfo;
 	if (unzOpenCurrentFile(_zipFile) != UNZ_OK)
 		return 0;
@@ -1510,22 +1806,47 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	}
 
 	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
-
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
 }
 
-Archive *makeZipArchive(const String &name) {
-	return makeZipArchive(SearchMan.createReadStreamForMember(name));
-}
+SeekableReadStream *ZipArchive::createStreamingReadStream(unz_s *archive) const {
+	uInt sizeVar;
+	uLong offsetLocalExtraField;
+	uInt sizeLocalExtraField;
 
-Archive *makeZipArchive(const FSNode &node) {
-	return makeZipArchive(node.createReadStream());
+	if (unzlocal_CheckCurrentFileCoherencyHeader(archive, &sizeVar, &offsetLocalExtraField, &sizeLocalExtraField) != UNZ_OK)
+		return 0;
+
+	const unz_file_info &fileInfo = archive->cur_file_info;
+	uint32 dataOffset = archive->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + sizeVar + archive->byte_before_the_zipfile;
+
+	bool deflated = false;
+#ifdef USE_ZLIB
+	deflated = (fileInfo.compression_method == Z_DEFLATED);
+#endif
+	if (fileInfo.compression_method != 0 && !deflated)
+		return 0;
+
+	// Open the archive again, so that the member stream does not share
+	// the position of the archive stream with other members. Make sure
+	// it is still the same file.
+	SeekableReadStream *stream = _source->createReadStream();
+	if (!stream)
+		return 0;
+
+	if (stream->size() != archive->_stream->size()) {
+		delete stream;
+		return 0;
+	}
+
+#ifdef USE_ZLIB
+	if (deflated)
+		return new ZipInflateStream(stream, dataOffset, fileInfo.compressed_size, fileInfo.uncompressed_size, fileInfo.crc);
+#endif
+
+	return new SeekableSubReadStream(stream, dataOffset, dataOffset + fileInfo.uncompressed_size, DisposeAfterUse::YES);
 }
 
-Archive *makeZipArchive(SeekableReadStream *stream) {
+static Archive *makeZipArchive(SeekableReadStream *stream, const ArchiveMemberPtr &source) {
 	if (!stream)
 		return 0;
 	unzFile zipFile = unzOpen(stream);
@@ -1534,7 +1855,23 @@ Archive *makeZipArchive(SeekableReadStream *stream) {
 		// goes wrong.
 		return 0;
 	}
-	return new ZipArchive(zipFile);
+	return new ZipArchive(zipFile, source);
+}
+
+Archive *makeZipArchive(const String &name) {
+	ArchiveMemberPtr member = SearchMan.getMember(name);
+	if (!member)
+		return 0;
+
+	return makeZipArchive(member->createReadStream(), member);
+}
+
+Archive *makeZipArchive(const FSNode &node) {
+	return makeZipArchive(node.createReadStream(), ArchiveMemberPtr(new FSNode(node)));
+}
+
+Archive *makeZipArchive(SeekableReadStream *stream) {
+	return makeZipArchive(stream, ArchiveMemberPtr());
 }
 
 } // End of namespace Common
@@ -33,6 +33,44 @@
 #include "engines/advancedDetector.h"
 #include "engines/obsolete.h"
 
+/**
+ * MD5 sums computed during the current detection run, keyed by the number
+ * of hashed bytes and the file path. Most engines probe the same files of a
+ * directory, so this avoids reading them again for every plugin. Only
+ * filled between beginDetectionRun() and endDetectionRun(), so files
+ * replaced between two runs are hashed again.
+ */
+typedef Common::HashMap<Common::String, ADFileProperties> ADFileMD5Cache;
+static ADFileMD5Cache s_md5Cache;
+
+/** Number of MD5 sums after which the cache is emptied */
+static const uint kMD5CacheMaxEntries = 1024;
+
+/**
+ * Subdirectory listings of the game directory currently being detected.
+ * Only filled between beginDetectionRun() and endDetectionRun().
+ */
+typedef Common::HashMap<Common::String, Common::FSList> ADDirectoryCache;
+static ADDirectoryCache s_directoryCache;
+static bool s_inDetectionRun = false;
+
+static bool getDirectoryChildren(const Common::FSNode &dir, Common::FSList &files) {
+	if (!s_inDetectionRun)
+		return dir.getChildren(files, Common::FSNode::kListAll);
+
+	ADDirectoryCache::const_iterator cached = s_directoryCache.find(dir.getPath());
+	if (cached != s_directoryCache.end()) {
+		files = cached->_value;
+		return true;
+	}
+
+	if (!dir.getChildren(files, Common::FSNode::kListAll))
+		return false;
+
+	s_directoryCache[dir.getPath()] = files;
+	return true;
+}
+
 static GameDescriptor toGameDescriptor(const ADGameDescription &g, const PlainGameDescriptor *sg) {
 	const char *title = 0;
 	const char *extra;
@@ -358,6 +396,18 @@ void AdvancedMetaEngine::reportUnknown(const Common::FSNode &path, const ADFileP
 	g_system->logMessage(LogMessageType::kInfo, report.c_str());
 }
 
+void AdvancedMetaEngine::beginDetectionRun() {
+	s_directoryCache.clear();
+	s_md5Cache.clear();
+	s_inDetectionRun = true;
+}
+
+void AdvancedMetaEngine::endDetectionRun() {
+	s_inDetectionRun = false;
+	s_directoryCache.clear();
+	s_md5Cache.clear();
+}
+
 void AdvancedMetaEngine::composeFileHashMap(FileMap &allFiles, const Common::FSList &fslist, int depth, const Common::String &parentName) const {
 	if (depth <= 0)
 		return;
@@ -384,7 +434,7 @@ void AdvancedMetaEngine::composeFileHashMap(FileMap &allFiles, const Common::FSL
 			if (!matched)
 				continue;
 
-			if (!file->getChildren(files, Common::FSNode::kListAll))
+			if (!getDirectoryChildren(*file, files))
 				continue;
 
 			composeFileHashMap(allFiles, files, depth - 1, tstr);
@@ -424,7 +474,23 @@ bool AdvancedMetaEngine::getFileProperties(const Common::FSNode &parent, const F
 		return false;
 
 	fileProps.size = (int32)testFile.size();
+
+	if (!s_inDetectionRun) {
+		fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+		return true;
+	}
+
+	const Common::String cacheKey = Common::String::format("%u:%s", _md5Bytes, allFiles[fname].getPath().c_str());
+	ADFileMD5Cache::const_iterator cached = s_md5Cache.find(cacheKey);
+	if (cached != s_md5Cache.end() && cached->_value.size == fileProps.size) {
+		fileProps.md5 = cached->_value.md5;
+		return true;
+	}
+
 	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+	if (s_md5Cache.size() >= kMD5CacheMaxEntries)
+		s_md5Cache.clear();
+	s_md5Cache[cacheKey] = fileProps;
 	return true;
 }
 
@@ -284,6 +284,17 @@ public:
 
 	virtual const ExtraGuiOptions getExtraGuiOptions(const Common::String &target) const;
 
+	/**
+	 * Start caching the listings of scanned subdirectories and the MD5 sums
+	 * of probed files, so that all engines detecting the same directory
+	 * only list and hash it once. Used by EngineManager::detectGames()
+	 * around a run over all engine plugins.
+	 */
+	static void beginDetectionRun();
+
+	/** Stop caching listings and MD5 sums, and drop the cached ones. */
+	static void endDetectionRun();
+
 protected:
 	// To be implemented by subclasses
 	virtual bool createInstance(OSystem *syst, Engine **engine, const ADGameDescription *desc) const = 0;
@@ -35,6 +35,7 @@
 
 #include "graphics/palette.h"
 #include "image/jpeg.h"
+#include "video/video_decoder.h"
 
 #ifdef USE_RGB_COLOR
 // Required for the YUV to RGB conversion
@@ -128,6 +129,24 @@ void ROQPlayer::buildShowBuf() {
 	if (_alpha)
 		_fg->copyFrom(*_bg);
 
+	if (!_alpha && _fg->h != 480 && _scaleX == _scaleY) {
+		// Without alpha or Gamepad transparency, the frame is copied as is
+		Video::VideoDecoder::writeFrameInto(*_currBuf, *_bg, 0, 0, nullptr, _scaleX);
+	} else {
+		buildShowBufMasked();
+	}
+
+	// On the first frame, copy from the current buffer to the prev buffer
+	if (_firstFrame) {
+		_prevBuf->copyFrom(*_currBuf);
+		_firstFrame = false;
+	}
+
+	// Swap buffers
+	SWAP(_prevBuf, _currBuf);
+}
+
+void ROQPlayer::buildShowBufMasked() {
 	for (int line = 0; line < _bg->h; line++) {
 		uint32 *out = _alpha ? (uint32 *)_fg->getBasePtr(0, line) : (uint32 *)_bg->getBasePtr(0, line);
 		uint32 *in = (uint32 *)_currBuf->getBasePtr(0, line / _scaleY);
@@ -148,15 +167,6 @@ void ROQPlayer::buildShowBuf() {
 				in++;
 		}
 	}
-
-	// On the first frame, copy from the current buffer to the prev buffer
-	if (_firstFrame) {
-		_prevBuf->copyFrom(*_currBuf);
-		_firstFrame = false;
-	}
-
-	// Swap buffers
-	SWAP(_prevBuf, _currBuf);
 }
 
 bool ROQPlayer::playFrameInternal() {
@@ -82,6 +82,7 @@ private:
 	Graphics::Surface *_fg, *_bg;
 	Graphics::Surface *_currBuf, *_prevBuf;
 	void buildShowBuf();
+	void buildShowBufMasked();
 	byte _scaleX, _scaleY;
 	byte _offScale;
 	bool _dirty;
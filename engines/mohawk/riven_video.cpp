@@ -51,6 +51,7 @@ RivenVideo::RivenVideo(MohawkEngine_Riven *vm, uint16 code) :
 
 RivenVideo::~RivenVideo() {
 	delete _video;
+	_convertedFrame.free();
 }
 
 void RivenVideo::load(uint16 id) {
@@ -72,6 +73,7 @@ void RivenVideo::close() {
 
 	delete _video;
 	_video = nullptr;
+	_convertedFrame.free();
 }
 
 bool RivenVideo::endOfVideo() const {
@@ -183,29 +185,32 @@ void RivenVideoManager::updateMovies() {
 }
 
 void RivenVideo::drawNextFrame() {
-	const Graphics::Surface *frame = _video->decodeNextFrame();
-
-	if (!frame || !isEnabled()) {
+	if (!isEnabled()) {
+		_video->decodeNextFrame();
 		return;
 	}
 
-	Graphics::Surface *convertedFrame = nullptr;
+	const Graphics::Surface *frame;
 	Graphics::PixelFormat pixelFormat = g_system->getScreenFormat();
 
-	if (frame->format != pixelFormat) {
-		// Convert to the current screen format
-		convertedFrame = frame->convertTo(pixelFormat, _video->getPalette());
-		frame = convertedFrame;
+	if (_video->getPixelFormat() == pixelFormat) {
+		frame = _video->decodeNextFrame();
+	} else {
+		// Convert to the current screen format while decoding
+		if (_convertedFrame.w != _video->getWidth() || _convertedFrame.h != _video->getHeight() || _convertedFrame.format != pixelFormat) {
+			_convertedFrame.free();
+			_convertedFrame.create(_video->getWidth(), _video->getHeight(), pixelFormat);
+		}
+
+		frame = _video->decodeNextFrameInto(_convertedFrame) ? &_convertedFrame : nullptr;
+	}
+
+	if (!frame) {
+		return;
 	}
 
 	g_system->copyRectToScreen(frame->getPixels(), frame->pitch,
 	                               _x, _y, _video->getWidth(), _video->getHeight());
-
-	// Delete 8bpp conversion surface
-	if (convertedFrame) {
-		convertedFrame->free();
-		delete convertedFrame;
-	}
 }
 
 bool RivenVideo::needsUpdate() const {
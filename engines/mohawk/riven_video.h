@@ -25,6 +25,7 @@
 
 #include "common/list.h"
 #include "common/noncopyable.h"
+#include "graphics/surface.h"
 
 namespace Video {
 class QuickTimeDecoder;
@@ -126,6 +127,9 @@ private:
 	bool _loop;
 	bool _enabled;
 	bool _playing;
+
+	// Frames converted to the screen format, kept between frames
+	Graphics::Surface _convertedFrame;
 };
 
 class RivenVideoManager {
@@ -54,6 +54,7 @@ VideoEntry::~VideoEntry() {
 void VideoEntry::close() {
 	delete _video;
 	_video = 0;
+	_convertedFrame.free();
 }
 
 bool VideoEntry::endOfVideo() const {
@@ -224,38 +225,45 @@ bool VideoManager::updateMovies() {
 
 bool VideoManager::drawNextFrame(VideoEntryPtr videoEntry) {
 	Video::VideoDecoder *video = videoEntry->_video;
-	const Graphics::Surface *frame = video->decodeNextFrame();
 
-	if (!frame || !videoEntry->isEnabled()) {
+	if (!videoEntry->isEnabled()) {
+		video->decodeNextFrame();
 		return false;
 	}
 
-	Graphics::Surface *convertedFrame = 0;
 	Graphics::PixelFormat pixelFormat = _vm->_system->getScreenFormat();
 
-	if (frame->format != pixelFormat) {
+	if (pixelFormat.bytesPerPixel == 1 && video->getPixelFormat().bytesPerPixel != 1) {
 		// We don't support downconverting to 8bpp without having
 		// support in the codec. Set _enableDither if shows up.
-		if (pixelFormat.bytesPerPixel == 1) {
+		if (video->decodeNextFrame())
 			warning("Cannot convert high color video frame to 8bpp");
-			return false;
+		return false;
+	}
+
+	const Graphics::Surface *frame;
+
+	if (video->getPixelFormat() == pixelFormat) {
+		frame = video->decodeNextFrame();
+	} else {
+		// Convert to the current screen format while decoding
+		Graphics::Surface &convertedFrame = videoEntry->_convertedFrame;
+		if (convertedFrame.w != video->getWidth() || convertedFrame.h != video->getHeight() || convertedFrame.format != pixelFormat) {
+			convertedFrame.free();
+			convertedFrame.create(video->getWidth(), video->getHeight(), pixelFormat);
 		}
 
-		// Convert to the current screen format
-		convertedFrame = frame->convertTo(pixelFormat, video->getPalette());
-		frame = convertedFrame;
-	} else if (pixelFormat.bytesPerPixel == 1 && video->hasDirtyPalette()) {
-		// Set the palette when running in 8bpp mode only
-		// Don't do this for Myst, which has its own per-stack handling
-		if (_vm->getGameType() != GType_MYST)
-			_vm->_system->getPaletteManager()->setPalette(video->getPalette(), 0, 256);
+		frame = video->decodeNextFrameInto(convertedFrame) ? &convertedFrame : 0;
 	}
 
+	if (!frame)
+		return false;
+
 	// Clip the video to make sure it stays on the screen (Myst does this a few times)
-	Common::Rect targetRect = Common::Rect(video->getWidth(), video->getHeight());
+	Common::Rect targetRect = Common::Rect(frame->w, frame->h);
 	targetRect.translate(videoEntry->getX(), videoEntry->getY());
 
-	Common::Rect frameRect = Common::Rect(video->getWidth(), video->getHeight());
+	Common::Rect frameRect = Common::Rect(frame->w, frame->h);
 
 	if (targetRect.left < 0) {
 		frameRect.left -= targetRect.left;
@@ -277,14 +285,14 @@ bool VideoManager::drawNextFrame(VideoEntryPtr videoEntry) {
 		targetRect.bottom = _vm->_system->getHeight();
 	}
 
-	_vm->_system->copyRectToScreen(frame->getBasePtr(frameRect.left, frameRect.top), frame->pitch,
-	                               targetRect.left, targetRect.top, targetRect.width(), targetRect.height());
+	if (!targetRect.isEmpty())
+		_vm->_system->copyRectToScreen(frame->getBasePtr(frameRect.left, frameRect.top), frame->pitch,
+		                               targetRect.left, targetRect.top, targetRect.width(), targetRect.height());
 
-	// Delete 8bpp conversion surface
-	if (convertedFrame) {
-		convertedFrame->free();
-		delete convertedFrame;
-	}
+	// Set the palette when running in 8bpp mode only
+	// Don't do this for Myst, which has its own per-stack handling
+	if (pixelFormat.bytesPerPixel == 1 && video->hasDirtyPalette() && _vm->getGameType() != GType_MYST)
+		_vm->_system->getPaletteManager()->setPalette(video->getPalette(), 0, 256);
 
 	// We've drawn something to the screen, make sure we update it
 	return true;
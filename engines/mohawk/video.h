@@ -31,6 +31,7 @@
 #include "common/ptr.h"
 #include "common/rational.h"
 #include "graphics/pixelformat.h"
+#include "graphics/surface.h"
 
 namespace Video {
 class VideoDecoder;
@@ -231,6 +232,9 @@ private:
 	bool _loop;
 	bool _enabled;
 	Audio::Timestamp _start;
+
+	// Frames converted to the screen format, kept between frames
+	Graphics::Surface _convertedFrame;
 };
 
 typedef Common::SharedPtr<VideoEntry> VideoEntryPtr;
@@ -39,6 +39,7 @@ public:
 		: SafeSeekableSubReadStream(parentStream, begin, end, disposeParentStream), _mutex(mutex) {
 	}
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
+	virtual const byte *borrowData(uint32 dataSize);
 protected:
 	Common::Mutex &_mutex;
 };
@@ -48,6 +49,11 @@ uint32 SafeMutexedSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return Common::SafeSeekableSubReadStream::read(dataPtr, dataSize);
 }
 
+const byte *SafeMutexedSeekableSubReadStream::borrowData(uint32 dataSize) {
+	Common::StackLock lock(_mutex);
+	return Common::SafeSeekableSubReadStream::borrowData(dataSize);
+}
+
 BlbArchive::BlbArchive() : _extData(NULL) {
 }
 
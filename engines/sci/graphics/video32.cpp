@@ -265,7 +265,9 @@ template <typename PixelType>
 void VideoPlayer::renderLQToSurface(Graphics::Surface &out, const Graphics::Surface &nextFrame, const bool doublePixels, const bool blackLines) const {
 
 	const int lineCount = blackLines ? 2 : 1;
-	if (doublePixels) {
+	if (doublePixels && !blackLines) {
+		Video::VideoDecoder::writeFrameInto(nextFrame, out, 0, 0, nullptr, 2);
+	} else if (doublePixels) {
 		for (int16 y = 0; y < nextFrame.h * 2; y += lineCount) {
 			const PixelType *source = (const PixelType *)nextFrame.getBasePtr(0, y >> 1);
 			PixelType *target = (PixelType *)out.getBasePtr(0, y);
@@ -21,6 +21,7 @@
  */
 
 #include "common/endian.h"
+#include "common/span.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -79,8 +80,8 @@ SEQDecoder::SEQVideoTrack::~SEQVideoTrack() {
 }
 
 void SEQDecoder::SEQVideoTrack::readPaletteChunk(uint16 chunkSize) {
-	byte *paletteData = new byte[chunkSize];
-	_fileStream->read(paletteData, chunkSize);
+	Common::StreamSpan paletteChunk(*_fileStream, chunkSize);
+	const byte *paletteData = paletteChunk->data();
 
 	// SCI1.1 palette
 	byte palFormat = paletteData[32];
@@ -99,7 +100,6 @@ void SEQDecoder::SEQVideoTrack::readPaletteChunk(uint16 chunkSize) {
 	}
 
 	_dirtyPalette = true;
-	delete[] paletteData;
 }
 
 const Graphics::Surface *SEQDecoder::SEQVideoTrack::decodeNextFrame() {
@@ -121,20 +121,14 @@ const Graphics::Surface *SEQDecoder::SEQVideoTrack::decodeNextFrame() {
 	if (frameType == kSeqFrameFull) {
 		byte *dst = (byte *)_surface->getBasePtr(frameLeft, frameTop);
 
-		byte *linebuf = new byte[frameWidth];
-
 		do {
-			_fileStream->read(linebuf, frameWidth);
-			memcpy(dst, linebuf, frameWidth);
+			_fileStream->read(dst, frameWidth);
 			dst += SEQ_SCREEN_WIDTH;
 		} while (--frameHeight);
-
-		delete[] linebuf;
 	} else {
-		byte *buf = new byte[frameSize];
-		_fileStream->read(buf, frameSize);
+		Common::StreamSpan frame(*_fileStream, frameSize);
+		const byte *buf = frame->data();
 		decodeFrame(buf, rleSize, buf + rleSize, frameSize - rleSize, (byte *)_surface->getBasePtr(0, frameTop), frameLeft, frameWidth, frameHeight, colorKey);
-		delete[] buf;
 	}
 
 	_curFrame++;
@@ -151,7 +145,7 @@ const Graphics::Surface *SEQDecoder::SEQVideoTrack::decodeNextFrame() {
 	} \
 	memcpy(dest + writeRow * SEQ_SCREEN_WIDTH + writeCol, litData + litPos, n);
 
-bool SEQDecoder::SEQVideoTrack::decodeFrame(byte *rleData, int rleSize, byte *litData, int litSize, byte *dest, int left, int width, int height, int colorKey) {
+bool SEQDecoder::SEQVideoTrack::decodeFrame(const byte *rleData, int rleSize, const byte *litData, int litSize, byte *dest, int left, int width, int height, int colorKey) {
 	int writeRow = 0;
 	int writeCol = left;
 	int litPos = 0;
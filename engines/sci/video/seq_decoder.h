@@ -72,7 +72,7 @@ private:
 		};
 
 		void readPaletteChunk(uint16 chunkSize);
-		bool decodeFrame(byte *rleData, int rleSize, byte *litData, int litSize, byte *dest, int left, int width, int height, int colorKey);
+		bool decodeFrame(const byte *rleData, int rleSize, const byte *litData, int litSize, byte *dest, int left, int width, int height, int colorKey);
 
 		Common::SeekableReadStream *_fileStream;
 		int _curFrame, _frameCount;
@@ -184,6 +184,17 @@ uint32 ScummFile::read(void *dataPtr, uint32 dataSize) {
 	return realLen;
 }
 
+const byte *ScummFile::borrowData(uint32 dataSize) {
+	// Encrypted data has to be copied to be decoded
+	if (_encbyte)
+		return 0;
+
+	if (_subFileLen && pos() + dataSize > (uint32)_subFileLen)
+		return 0;
+
+	return File::borrowData(dataSize);
+}
+
 #pragma mark -
 #pragma mark --- ScummSteamFile ---
 #pragma mark -
@@ -45,6 +45,10 @@ public:
 	virtual int32 size() const = 0;
 	virtual bool seek(int32 offs, int whence = SEEK_SET) = 0;
 
+	// Data is not lent out unless a subclass knows it is stored as is
+	virtual const byte *borrowData(uint32 dataSize) { return 0; }
+	virtual bool hasDataInMemory() const { return false; }
+
 // Unused
 #if 0
 	virtual bool eos() const = 0;
@@ -74,6 +78,8 @@ public:
 	int32 size() const;
 	bool seek(int32 offs, int whence = SEEK_SET);
 	uint32 read(void *dataPtr, uint32 dataSize);
+	const byte *borrowData(uint32 dataSize);
+	bool hasDataInMemory() const { return !_encbyte && File::hasDataInMemory(); }
 };
 
 class ScummDiskImage : public BaseScummFile {
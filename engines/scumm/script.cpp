@@ -21,6 +21,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/debug-channels.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -442,22 +443,37 @@ void ScummEngine::resetScriptPointer() {
 }
 
 /**
- * This method checks whether the resource that contains the active script
- * moved, and if so, updates the script pointer accordingly.
+ * Updates the script pointer after the resource that contains the active
+ * script moved. refreshScriptPointer() checks whether it did.
  *
  * The script resource may have moved because it might have been garbage
  * collected by ResourceManager::expireResources.
  */
-void ScummEngine::refreshScriptPointer() {
-	if (*_lastCodePtr != _scriptOrgPointer) {
-		long oldoffs = _scriptPointer - _scriptOrgPointer;
-		getScriptBaseAddress();
-		_scriptPointer = _scriptOrgPointer + oldoffs;
-	}
+void ScummEngine::relocateScriptPointer() {
+	long oldoffs = _scriptPointer - _scriptOrgPointer;
+	getScriptBaseAddress();
+	_scriptPointer = _scriptOrgPointer + oldoffs;
 }
 
 /** Execute a script - Read opcode, and execute it from the table */
 void ScummEngine::executeScript() {
+	// The debugger only changes these between frames, so checking them
+	// once keeps the per opcode work of the loop below to a minimum.
+	if (_showStack || _hexdumpScripts || gDebugLevel == 11 || DebugMan.isDebugChannelEnabled(DEBUG_OPCODES)) {
+		executeScriptDebug();
+		return;
+	}
+
+	while (_currentScript != 0xFF) {
+		_opcode = fetchScriptByte();
+		if (_game.version > 2) // V0-V2 games didn't use the didexec flag
+			vm.slot[_currentScript].didexec = true;
+		executeOpcode(_opcode);
+	}
+}
+
+/** Like executeScript, but traces each opcode as requested by the debugger */
+void ScummEngine::executeScriptDebug() {
 	int c;
 	while (_currentScript != 0xFF) {
 
@@ -489,7 +505,8 @@ void ScummEngine::executeScript() {
 }
 
 void ScummEngine::executeOpcode(byte i) {
-	if (_opcodes[i].proc && _opcodes[i].proc->isValid())
+	// OpcodeEntry only keeps valid procs
+	if (_opcodes[i].proc)
 		(*_opcodes[i].proc)();
 	else {
 		error("Invalid opcode '%x' at %lx", i, (long)(_scriptPointer - _scriptOrgPointer));
@@ -504,11 +521,6 @@ const char *ScummEngine::getOpcodeDesc(byte i) {
 #endif
 }
 
-byte ScummEngine::fetchScriptByte() {
-	refreshScriptPointer();
-	return *_scriptPointer++;
-}
-
 uint ScummEngine::fetchScriptWord() {
 	refreshScriptPointer();
 	uint a = READ_LE_UINT16(_scriptPointer);
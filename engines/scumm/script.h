@@ -45,6 +45,12 @@ struct OpcodeEntry : Common::NonCopyable {
 	}
 
 	void setProc(Opcode *p, const char *d) {
+		// Only keep valid procs, so that dispatching an opcode does not
+		// need to check that.
+		if (p && !p->isValid()) {
+			delete p;
+			p = 0;
+		}
 		if (proc != p) {
 			delete proc;
 			proc = p;
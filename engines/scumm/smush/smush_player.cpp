@@ -20,8 +20,10 @@
  *
  */
 
+#include "common/bufferedstream.h"
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/span.h"
 #include "common/system.h"
 #include "common/util.h"
 
@@ -795,15 +797,17 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 	}
 
 	int32 chunkSize = subSize;
-	byte *chunkBuffer = (byte *)malloc(chunkSize);
-	assert(chunkBuffer);
-	b.read(chunkBuffer, chunkSize);
-
-	unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
-	byte *fobjBuffer = (byte *)malloc(decompressedSize);
-	if (!Common::uncompress(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
-		error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
-	free(chunkBuffer);
+	byte *fobjBuffer;
+	unsigned long decompressedSize;
+	{
+		Common::StreamSpan chunk(b, chunkSize);
+		const byte *chunkBuffer = chunk->data();
+
+		decompressedSize = READ_BE_UINT32(chunkBuffer);
+		fobjBuffer = (byte *)malloc(decompressedSize);
+		if (!Common::uncompress(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
+			error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
+	}
 
 	byte *ptr = fobjBuffer;
 	int codec = READ_LE_UINT16(ptr); ptr += 2;
@@ -835,13 +839,9 @@ void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b
 	b.readUint16LE();
 
 	int32 chunk_size = subSize - 14;
-	byte *chunk_buffer = (byte *)malloc(chunk_size);
-	assert(chunk_buffer);
-	b.read(chunk_buffer, chunk_size);
-
-	decodeFrameObject(codec, chunk_buffer, left, top, width, height);
+	Common::StreamSpan chunk(b, chunk_size);
 
-	free(chunk_buffer);
+	decodeFrameObject(codec, chunk->data(), left, top, width, height);
 }
 
 void SmushPlayer::handleFrame(int32 frameSize, Common::SeekableReadStream &b) {
@@ -992,7 +992,8 @@ void SmushPlayer::parseNextFrame() {
 			ScummFile *tmp = new ScummFile();
 			if (!g_scumm->openFile(*tmp, _seekFile))
 				error("SmushPlayer: Unable to open file %s", _seekFile.c_str());
-			_base = tmp;
+			// Videos are mostly read front to back, often from CD or other slow media
+			_base = Common::wrapReadAheadSeekableReadStream(tmp, 256 * 1024, DisposeAfterUse::YES);
 			_base->readUint32BE();
 			_baseSize = _base->readUint32BE();
 
@@ -33,6 +33,11 @@
 #include "graphics/VectorRenderer.h"
 #include "graphics/VectorRendererSpec.h"
 
+#if defined(__SSE2__) && defined(SCUMM_LITTLE_ENDIAN)
+#include <emmintrin.h>
+#define VECTOR_RENDERER_SSE2
+#endif
+
 #define VECTOR_RENDERER_FAST_TRIANGLES
 
 /** Fixed point SQUARE ROOT **/
@@ -446,6 +451,18 @@ void colorFill(PixelType *first, PixelType *last, PixelType color) {
 	register int count = (last - first);
 	if (!count)
 		return;
+
+#ifdef VECTOR_RENDERER_SSE2
+	const int pixelsPerVector = 16 / sizeof(PixelType);
+	if (count >= pixelsPerVector) {
+		const __m128i fill = (sizeof(PixelType) == 2) ? _mm_set1_epi16((short)color) : _mm_set1_epi32((int)color);
+		for (; count >= pixelsPerVector; count -= pixelsPerVector, first += pixelsPerVector)
+			_mm_storeu_si128((__m128i *)first, fill);
+		if (!count)
+			return;
+	}
+#endif
+
 	register int n = (count + 7) >> 3;
 	switch (count % 8) {
 	case 0: do {
@@ -461,6 +478,38 @@ void colorFill(PixelType *first, PixelType *last, PixelType color) {
 	}
 }
 
+/**
+ * Fills several pixels in a row with two alternating colors, as used for
+ * the dithered rows of gradients.
+ *
+ * @param first Pointer to the first pixel to fill.
+ * @param last Pointer to the last pixel to fill.
+ * @param color1 Color of the first pixel, and of every second one after it.
+ * @param color2 Color of the other pixels.
+ */
+template<typename PixelType>
+void colorFillAlternate(PixelType *first, PixelType *last, PixelType color1, PixelType color2) {
+	int count = (last - first);
+
+#ifdef VECTOR_RENDERER_SSE2
+	const int pixelsPerVector = 16 / sizeof(PixelType);
+	if (count >= pixelsPerVector) {
+		const __m128i fill = (sizeof(PixelType) == 2) ?
+			_mm_set1_epi32((int)((uint32)color1 | ((uint32)color2 << 16))) :
+			_mm_set_epi32((int)color2, (int)color1, (int)color2, (int)color1);
+		for (; count >= pixelsPerVector; count -= pixelsPerVector, first += pixelsPerVector)
+			_mm_storeu_si128((__m128i *)first, fill);
+	}
+#endif
+
+	for (; count >= 2; count -= 2) {
+		*first++ = color1;
+		*first++ = color2;
+	}
+	if (count > 0)
+		*first = color1;
+}
+
 template<typename PixelType>
 void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX, int realY, Common::Rect &clippingArea) {
 	if (realY < clippingArea.top || realY >= clippingArea.bottom)
@@ -602,13 +651,20 @@ precalcGradient(int h) {
 }
 
 template<typename PixelType>
-void VectorRendererSpec<PixelType>::
-gradientFill(PixelType *ptr, int width, int x, int y) {
+bool VectorRendererSpec<PixelType>::
+gradientRowColors(int y, PixelType &evenColor, PixelType &oddColor) {
 	bool ox = ((y & 1) == 1);
-	int curGrad = 0;
 
-	while (_gradIndexes[curGrad + 1] <= y)
-		curGrad++;
+	// Find the last strip starting at or before y. _gradIndexes is sorted,
+	// and the strip after it always exists.
+	int curGrad = 0, lastGrad = _gradIndexes.size() - 2;
+	while (curGrad < lastGrad) {
+		int mid = (curGrad + lastGrad + 1) / 2;
+		if (_gradIndexes[mid] <= y)
+			curGrad = mid;
+		else
+			lastGrad = mid - 1;
+	}
 
 	// precalcGradient assures that _gradIndexes entries always differ in
 	// their value. This assures stripSize is always different from zero.
@@ -625,64 +681,58 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	if (grad == 0 ||
 		_gradCache[curGrad] == _gradCache[curGrad + 1] || // no color change
 		stripSize < 2) { // the stip is small
-		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad]);
+		evenColor = oddColor = _gradCache[curGrad];
+		return false;
 	} else if (grad == 3 && ox) {
-		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
+		evenColor = oddColor = _gradCache[curGrad + 1];
+		return false;
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		evenColor = ((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+		oddColor = (ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+		return true;
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+gradientFill(PixelType *ptr, int width, int x, int y) {
+	PixelType evenColor, oddColor;
+	gradientRowColors(y, evenColor, oddColor);
+
+	if (evenColor == oddColor)
+		colorFill<PixelType>(ptr, ptr + width, evenColor);
+	else if (x & 1)
+		colorFillAlternate<PixelType>(ptr, ptr + width, oddColor, evenColor);
+	else
+		colorFillAlternate<PixelType>(ptr, ptr + width, evenColor, oddColor);
+}
+
 template<typename PixelType>
 void VectorRendererSpec<PixelType>::
 gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY) {
 	if (realY < _clippingArea.top || realY >= _clippingArea.bottom) return;
-	bool ox = ((y & 1) == 1);
-	int curGrad = 0;
-
-	while (_gradIndexes[curGrad + 1] <= y)
-		curGrad++;
 
-	// precalcGradient assures that _gradIndexes entries always differ in
-	// their value. This assures stripSize is always different from zero.
-	int stripSize = _gradIndexes[curGrad + 1] - _gradIndexes[curGrad];
-
-	int grad = (((y - _gradIndexes[curGrad]) % stripSize) << 2) / stripSize;
+	PixelType evenColor, oddColor;
+	if (!gradientRowColors(y, evenColor, oddColor)) {
+		colorFill<PixelType>(ptr, ptr + width, evenColor);
+		return;
+	}
 
-	// Dithering:
-	//   +--+ +--+ +--+ +--+
-	//   |  | |  | | *| | *|
-	//   |  | | *| |* | |**|
-	//   +--+ +--+ +--+ +--+
-	//     0    1    2    3
-	if (grad == 0 ||
-		_gradCache[curGrad] == _gradCache[curGrad + 1] || // no color change
-		stripSize < 2) { // the stip is small
-		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad]);
-	} else if (grad == 3 && ox) {
-		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
-	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+	if (realX < _clippingArea.left) {
+		int diff = _clippingArea.left - realX;
+		ptr += diff;
+		x += diff;
+		width -= diff;
+		realX += diff;
 	}
+	width = MIN<int>(width, _clippingArea.right - realX);
+	if (width <= 0)
+		return;
+
+	if (x & 1)
+		colorFillAlternate<PixelType>(ptr, ptr + width, oddColor, evenColor);
+	else
+		colorFillAlternate<PixelType>(ptr, ptr + width, evenColor, oddColor);
 }
 
 template<typename PixelType>
@@ -1062,6 +1112,140 @@ blendPixelPtrClip(PixelType *ptr, PixelType color, uint8 alpha, int x, int y) {
 		blendPixelPtr(ptr, color, alpha);
 }
 
+#ifdef VECTOR_RENDERER_SSE2
+
+/**
+ * Blends one channel of eight 16-bit pixels, like blendPixelPtr does, as
+ * (dst * (256 - alpha) + src * alpha) >> 8.
+ *
+ * @param pixels The destination pixels.
+ * @param shift Shift of the channel.
+ * @param mask Mask of the channel, once shifted down.
+ * @param invAlpha 256 - alpha, in all lanes.
+ * @param src Source channel value multiplied by alpha, in all lanes.
+ */
+static inline __m128i blendChannelSSE2(__m128i pixels, __m128i shift, __m128i mask, __m128i invAlpha, __m128i src) {
+	const __m128i dst = _mm_and_si128(_mm_srl_epi16(pixels, shift), mask);
+	const __m128i res = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(dst, invAlpha), src), 8);
+	return _mm_sll_epi16(res, shift);
+}
+
+#endif
+
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+	int count = last - first;
+	if (count <= 0)
+		return;
+
+	if (alpha == 0xff) {
+		// fully opaque pixels, don't blend
+		colorFill<PixelType>(first, last, color | _alphaMask);
+		return;
+	}
+
+	// Not worth setting up for a few pixels, as in vertical borders
+	if (count < 4) {
+		while (first != last)
+			blendPixelPtr(first++, color, alpha);
+		return;
+	}
+
+	// blendPixelPtr computes dst + (((src - dst) * alpha) >> 8) for each
+	// channel, which is the same as (dst * (256 - alpha) + src * alpha) >> 8.
+	// The second term is constant for the whole row.
+	const uint invAlpha = 256 - alpha;
+	const uint srcR = ((color & _redMask) >> _format.rShift) * alpha;
+	const uint srcG = ((color & _greenMask) >> _format.gShift) * alpha;
+	const uint srcB = ((color & _blueMask) >> _format.bShift) * alpha;
+	const uint srcA = ((sizeof(PixelType) == 4) ? 0xff : (uint)(_alphaMask >> _format.aShift)) * alpha;
+
+#ifdef VECTOR_RENDERER_SSE2
+	if (sizeof(PixelType) == 2 && count >= 8) {
+		const __m128i invAlphaV = _mm_set1_epi16((short)invAlpha);
+		const __m128i rShift = _mm_cvtsi32_si128(_format.rShift), rMask = _mm_set1_epi16((short)(_redMask >> _format.rShift)), rSrc = _mm_set1_epi16((short)srcR);
+		const __m128i gShift = _mm_cvtsi32_si128(_format.gShift), gMask = _mm_set1_epi16((short)(_greenMask >> _format.gShift)), gSrc = _mm_set1_epi16((short)srcG);
+		const __m128i bShift = _mm_cvtsi32_si128(_format.bShift), bMask = _mm_set1_epi16((short)(_blueMask >> _format.bShift)), bSrc = _mm_set1_epi16((short)srcB);
+		const __m128i aShift = _mm_cvtsi32_si128(_format.aShift), aMask = _mm_set1_epi16((short)(_alphaMask >> _format.aShift)), aSrc = _mm_set1_epi16((short)srcA);
+
+		for (; count >= 8; count -= 8, first += 8) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)first);
+			__m128i res = blendChannelSSE2(pixels, rShift, rMask, invAlphaV, rSrc);
+			res = _mm_or_si128(res, blendChannelSSE2(pixels, gShift, gMask, invAlphaV, gSrc));
+			res = _mm_or_si128(res, blendChannelSSE2(pixels, bShift, bMask, invAlphaV, bSrc));
+			res = _mm_or_si128(res, blendChannelSSE2(pixels, aShift, aMask, invAlphaV, aSrc));
+			_mm_storeu_si128((__m128i *)first, res);
+		}
+	} else if (sizeof(PixelType) == 4 && count >= 4 && _format.rLoss == 0 && _format.gLoss == 0 && _format.bLoss == 0 &&
+	           (_format.aLoss == 0 || _format.aLoss == 8) && ((_format.rShift | _format.gShift | _format.bShift | _format.aShift) & 7) == 0) {
+		// Every channel is a whole byte, so the pixels can be unpacked to
+		// 16 bits per byte. Bytes without a channel are cleared by the mask.
+		uint16 src[4] = { 0, 0, 0, 0 };
+		src[_format.rShift >> 3] = srcR;
+		src[_format.gShift >> 3] = srcG;
+		src[_format.bShift >> 3] = srcB;
+		if (_alphaMask)
+			src[_format.aShift >> 3] = srcA;
+
+		const __m128i invAlphaV = _mm_set1_epi16((short)invAlpha);
+		const __m128i srcV = _mm_set_epi16(src[3], src[2], src[1], src[0], src[3], src[2], src[1], src[0]);
+		const __m128i maskV = _mm_set1_epi32((int)(_redMask | _greenMask | _blueMask | _alphaMask));
+		const __m128i zero = _mm_setzero_si128();
+
+		for (; count >= 4; count -= 4, first += 4) {
+			const __m128i pixels = _mm_loadu_si128((const __m128i *)first);
+			__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+			__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+			lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, invAlphaV), srcV), 8);
+			hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, invAlphaV), srcV), 8);
+			_mm_storeu_si128((__m128i *)first, _mm_and_si128(_mm_packus_epi16(lo, hi), maskV));
+		}
+	}
+#endif
+
+	if (sizeof(PixelType) == 2) {
+		// The channels can stay in place, as the bits shifted in below
+		// each of them are masked out again
+		const uint srcRMask = srcR << _format.rShift, srcGMask = srcG << _format.gShift;
+		const uint srcBMask = srcB << _format.bShift, srcAMask = srcA << _format.aShift;
+
+		for (; count > 0; --count, ++first) {
+			const uint dst = *first;
+			*first = (PixelType)(
+				((((dst & _redMask) * invAlpha + srcRMask) >> 8) & _redMask) |
+				((((dst & _greenMask) * invAlpha + srcGMask) >> 8) & _greenMask) |
+				((((dst & _blueMask) * invAlpha + srcBMask) >> 8) & _blueMask) |
+				((((dst & _alphaMask) * invAlpha + srcAMask) >> 8) & _alphaMask));
+		}
+	} else {
+		for (; count > 0; --count, ++first) {
+			const PixelType dst = *first;
+			*first = (PixelType)(
+				((((((dst & _redMask) >> _format.rShift) * invAlpha + srcR) >> 8) << _format.rShift) & _redMask) |
+				((((((dst & _greenMask) >> _format.gShift) * invAlpha + srcG) >> 8) << _format.gShift) & _greenMask) |
+				((((((dst & _blueMask) >> _format.bShift) * invAlpha + srcB) >> 8) << _format.bShift) & _blueMask) |
+				((((((dst & _alphaMask) >> _format.aShift) * invAlpha + srcA) >> 8) << _format.aShift) & _alphaMask));
+		}
+	}
+}
+
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
+	if (realY < _clippingArea.top || realY >= _clippingArea.bottom)
+		return;
+
+	if (realX < _clippingArea.left) {
+		first += _clippingArea.left - realX;
+		realX = _clippingArea.left;
+	}
+	if (last - first > _clippingArea.right - realX)
+		last = first + (_clippingArea.right - realX);
+
+	blendFill(first, last, color, alpha);
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 blendPixelDestAlphaPtr(PixelType *ptr, PixelType color, uint8 alpha) {
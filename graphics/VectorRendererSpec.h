@@ -275,6 +275,18 @@ protected:
 	inline PixelType calcGradient(uint32 pos, uint32 max);
 
 	void precalcGradient(int h);
+
+	/**
+	 * Looks up the colors of a row of the precalculated gradient. Dithered
+	 * rows alternate between two colors; other rows get the same color twice.
+	 *
+	 * @param y Row of the gradient.
+	 * @param evenColor Color of the pixels in even columns.
+	 * @param oddColor Color of the pixels in odd columns.
+	 * @return Whether the row is dithered.
+	 */
+	bool gradientRowColors(int y, PixelType &evenColor, PixelType &oddColor);
+
 	void gradientFill(PixelType *first, int width, int x, int y);
 	void gradientFillClip(PixelType *first, int width, int x, int y, int realX, int realY);
 
@@ -288,21 +300,8 @@ protected:
 	 * @param color Color of the pixel
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
-	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
-		while (first != last) blendPixelPtr(first++, color, alpha);
-	}
-
-	inline void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
-		if (_clippingArea.top <= realY && realY < _clippingArea.bottom) {
-			while (first != last) {
-				if (_clippingArea.left <= realX && realX < _clippingArea.right)
-					blendPixelPtr(first++, color, alpha);
-				else
-					++first;
-				++realX;
-			}
-		}
-	}
+	void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha);
+	void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY);
 
 	void darkenFill(PixelType *first, PixelType *last);
 	void darkenFillClip(PixelType *first, PixelType *last, int x, int y);
@@ -44,12 +44,11 @@ Common::Rect getBoundingBoxImpl(const Font &font, const StringType &str, int x,
 	// that we do allow an empty width to be specified here. This allows us
 	// to obtain the complete bounding box of a string.
 	const int leftX = x, rightX = w ? (x + w) : 0x7FFFFFFF;
-	int width = font.getStringWidth(str);
 
 	if (align == kTextAlignCenter)
-		x = x + (w - width)/2;
+		x = x + (w - font.getStringWidth(str))/2;
 	else if (align == kTextAlignRight)
-		x = x + w - width;
+		x = x + w - font.getStringWidth(str);
 	x += deltax;
 
 	bool first = true;
@@ -100,12 +99,13 @@ void drawStringImpl(const Font &font, Surface *dst, const StringType &str, int x
 	assert(dst != 0);
 
 	const int leftX = x, rightX = x + w;
-	int width = font.getStringWidth(str);
 
+	// Left aligned text does not need the width, and measuring it costs
+	// about as much as drawing the string
 	if (align == kTextAlignCenter)
-		x = x + (w - width)/2;
+		x = x + (w - font.getStringWidth(str))/2;
 	else if (align == kTextAlignRight)
-		x = x + w - width;
+		x = x + w - font.getStringWidth(str);
 	x += deltax;
 
 	typename StringType::unsigned_type last = 0;
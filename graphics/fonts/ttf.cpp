@@ -133,17 +133,82 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
-		Surface image;
+		int atlasX, atlasY;
+		int width, height;
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
 	};
 
+	enum {
+		kNoGlyph = -1,
+		kKerningTableSize = 128,
+		kUnknownKerning = -32768
+	};
+
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
-	typedef Common::HashMap<uint32, Glyph> GlyphCache;
-	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
-	void assureCached(uint32 chr) const;
+
+	/**
+	 * Returns the glyph of the given character, loading it if necessary.
+	 * The pointer is only valid until the next glyph is loaded.
+	 */
+	const Glyph *findGlyph(uint32 chr) const;
+
+	/**
+	 * Adds a glyph to the cache, and returns its index in _glyphs
+	 */
+	int addGlyph(const Glyph &glyph) const;
+
+	/**
+	 * All the loaded glyphs
+	 */
+	mutable Common::Array<Glyph> _glyphs;
+
+	/**
+	 * Index into _glyphs of the glyphs of the first 256 characters, which are
+	 * all loaded with the font
+	 */
+	int _directGlyphs[256];
+
+	/**
+	 * Index into _glyphs of the glyphs of any other characters, or kNoGlyph
+	 * for characters the font has no glyph for
+	 */
+	typedef Common::HashMap<uint32, int> GlyphIndexMap;
+	mutable GlyphIndexMap _glyphIndex;
+
+	/**
+	 * The images of all glyphs are packed into this surface, in rows as
+	 * high as their tallest glyph
+	 */
+	mutable Surface _atlas;
+	mutable int _atlasRowX, _atlasRowY, _atlasRowHeight;
+
+	/**
+	 * Reserves an area of the given size in the atlas, growing it if needed
+	 */
+	void allocateAtlasArea(int w, int h, int &x, int &y) const;
+
+	/**
+	 * Reallocates the atlas with a new size, keeping its contents
+	 */
+	void resizeAtlas(int w, int h) const;
+
+	/**
+	 * Kerning between each pair of the first kKerningTableSize characters,
+	 * or kUnknownKerning if it has not been queried yet
+	 */
+	mutable int16 *_kerningTable;
+
+	/**
+	 * Kerning between pairs of glyphs outside of the table, indexed by their
+	 * glyph indices
+	 */
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerningCache;
+
+	int getGlyphKerning(FT_UInt leftGlyph, FT_UInt rightGlyph) const;
 
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
@@ -158,20 +223,23 @@ private:
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
-      _hasKerning(false), _allowLateCaching(false) {
+      _descent(0), _allowLateCaching(false), _glyphs(), _atlasRowX(0), _atlasRowY(0), _atlasRowHeight(0),
+      _kerningTable(0), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
+      _hasKerning(false) {
+	for (uint i = 0; i < ARRAYSIZE(_directGlyphs); ++i)
+		_directGlyphs[i] = kNoGlyph;
 }
 
 TTFFont::~TTFFont() {
+	_atlas.free();
+	delete[] _kerningTable;
+
 	if (_initialized) {
 		g_ttf.closeFont(_face);
 
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
 }
@@ -251,9 +319,9 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode siz
 
 		// Load all ISO-8859-1 characters.
 		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], i)) {
-				_glyphs.erase(i);
-			}
+			Glyph glyph;
+			if (cacheGlyph(glyph, i))
+				_directGlyphs[i] = addGlyph(glyph);
 		}
 	} else {
 		// We have a fixed map of characters do not load more later.
@@ -264,14 +332,21 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode siz
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
 			// Check whether loading an important glyph fails and error out if
 			// that is the case.
-			if (!cacheGlyph(_glyphs[i], unicode)) {
-				_glyphs.erase(i);
-				if (isRequired)
-					return false;
+			Glyph glyph;
+			if (cacheGlyph(glyph, unicode)) {
+				_directGlyphs[i] = addGlyph(glyph);
+			} else if (isRequired) {
+				return false;
 			}
 		}
 	}
 
+	if (_hasKerning) {
+		_kerningTable = new int16[kKerningTableSize * kKerningTableSize];
+		for (uint i = 0; i < kKerningTableSize * kKerningTableSize; ++i)
+			_kerningTable[i] = kUnknownKerning;
+	}
+
 	_initialized = (_glyphs.size() != 0);
 	return _initialized;
 }
@@ -405,56 +480,80 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph)
 		return 0;
 	else
-		return glyphEntry->_value.advance;
+		return glyph->advance;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
+	// Most text is ASCII, so the kerning of those pairs is kept in a table
+	// indexed by the characters themselves
+	int16 *tableEntry = 0;
+	if (left < kKerningTableSize && right < kKerningTableSize) {
+		tableEntry = &_kerningTable[left * kKerningTableSize + right];
+		if (*tableEntry != kUnknownKerning)
+			return *tableEntry;
+	}
 
 	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
+	const Glyph *glyph;
 
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
+	glyph = findGlyph(left);
+	if (glyph) {
+		leftGlyph = glyph->slot;
 	} else {
-		return 0;
+		leftGlyph = 0;
 	}
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
+	glyph = findGlyph(right);
+	if (glyph) {
+		rightGlyph = glyph->slot;
 	} else {
-		return 0;
+		rightGlyph = 0;
 	}
 
+	const int kerning = getGlyphKerning(leftGlyph, rightGlyph);
+	if (tableEntry)
+		*tableEntry = kerning;
+	return kerning;
+}
+
+int TTFFont::getGlyphKerning(FT_UInt leftGlyph, FT_UInt rightGlyph) const {
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
+	// Glyph indices of TrueType fonts fit in 16 bits, anything else is not
+	// worth caching
+	const bool cacheable = (leftGlyph <= 0xFFFF && rightGlyph <= 0xFFFF);
+	const uint32 key = (leftGlyph << 16) | rightGlyph;
+	if (cacheable) {
+		KerningCache::const_iterator i = _kerningCache.find(key);
+		if (i != _kerningCache.end())
+			return i->_value;
+	}
+
 	FT_Vector kerningVector;
 	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	const int kerning = kerningVector.x / 64;
+
+	if (cacheable)
+		_kerningCache[key] = kerning;
+	return kerning;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
+		const int xOffset = glyph->xOffset;
+		const int yOffset = glyph->yOffset;
+		return Common::Rect(xOffset, yOffset, xOffset + glyph->width, yOffset + glyph->height);
 	}
 }
 
@@ -497,12 +596,11 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyphEntry = findGlyph(chr);
+	if (!glyphEntry)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = *glyphEntry;
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -512,10 +610,11 @@ void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) con
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.width;
+	int h = glyph.height;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	const uint8 *srcPos = (const uint8 *)_atlas.getBasePtr(glyph.atlasX, glyph.atlasY);
+	const int srcPitch = _atlas.pitch;
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -531,7 +630,7 @@ void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) con
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * srcPitch;
 		h += y;
 		y = 0;
 	}
@@ -560,12 +659,12 @@ void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) con
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += srcPitch;
 		}
 	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format);
 	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format);
 	}
 }
 
@@ -594,7 +693,14 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	glyph.advance = ftCeil26_6(_face->glyph->advance.x);
 
 	const FT_Bitmap &bitmap = _face->glyph->bitmap;
-	glyph.image.create(bitmap.width, bitmap.rows, PixelFormat::createFormatCLUT8());
+	if (bitmap.pixel_mode != FT_PIXEL_MODE_MONO && bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
+		return false;
+	}
+
+	glyph.width = bitmap.width;
+	glyph.height = bitmap.rows;
+	allocateAtlasArea(glyph.width, glyph.height, glyph.atlasX, glyph.atlasY);
 
 	const uint8 *src = bitmap.buffer;
 	int srcPitch = bitmap.pitch;
@@ -603,8 +709,9 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
+	// The atlas area is already cleared
+	uint8 *dst = (uint8 *)_atlas.getBasePtr(glyph.atlasX, glyph.atlasY);
+	const int dstPitch = _atlas.pitch;
 
 	switch (bitmap.pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
@@ -617,42 +724,92 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					dst[x] = 255;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += dstPitch;
 			src += srcPitch;
 		}
 		break;
 
-	case FT_PIXEL_MODE_GRAY:
+	default:
 		for (int y = 0; y < (int)bitmap.rows; ++y) {
 			memcpy(dst, src, bitmap.width);
-			dst += glyph.image.pitch;
+			dst += dstPitch;
 			src += srcPitch;
 		}
 		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 	return true;
 }
 
-void TTFFont::assureCached(uint32 chr) const {
-	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
-		return;
+const TTFFont::Glyph *TTFFont::findGlyph(uint32 chr) const {
+	if (chr < ARRAYSIZE(_directGlyphs)) {
+		const int index = _directGlyphs[chr];
+		return (index == kNoGlyph) ? 0 : &_glyphs[index];
 	}
 
+	if (!_allowLateCaching)
+		return 0;
+
+	GlyphIndexMap::const_iterator i = _glyphIndex.find(chr);
+	if (i != _glyphIndex.end())
+		return (i->_value == kNoGlyph) ? 0 : &_glyphs[i->_value];
+
+	// Remember characters without a glyph as well, so that they are only
+	// looked up once
 	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
-		_glyphs[chr] = newGlyph;
+	const int index = cacheGlyph(newGlyph, chr) ? addGlyph(newGlyph) : (int)kNoGlyph;
+	_glyphIndex[chr] = index;
+	return (index == kNoGlyph) ? 0 : &_glyphs[index];
+}
+
+int TTFFont::addGlyph(const Glyph &glyph) const {
+	_glyphs.push_back(glyph);
+	return _glyphs.size() - 1;
+}
+
+void TTFFont::allocateAtlasArea(int w, int h, int &x, int &y) const {
+	if (!w || !h) {
+		x = y = 0;
+		return;
+	}
+
+	// Start a new row when the current one is full
+	if (_atlasRowX + w > _atlas.w) {
+		_atlasRowY += _atlasRowHeight;
+		_atlasRowX = 0;
+		_atlasRowHeight = 0;
+	}
+
+	const int neededWidth = MAX<int>(w, _atlas.w);
+	const int neededHeight = _atlasRowY + h;
+	if (neededWidth > _atlas.w || neededHeight > _atlas.h) {
+		resizeAtlas(MAX<int>(neededWidth, 256),
+			MAX<int>(neededHeight, MAX<int>(_atlas.h * 2, 64)));
 	}
+
+	x = _atlasRowX;
+	y = _atlasRowY;
+	_atlasRowX += w;
+	_atlasRowHeight = MAX(_atlasRowHeight, h);
+}
+
+void TTFFont::resizeAtlas(int w, int h) const {
+	Surface newAtlas;
+	newAtlas.create(w, h, PixelFormat::createFormatCLUT8());
+	memset(newAtlas.getPixels(), 0, newAtlas.h * newAtlas.pitch);
+
+	if (_atlas.getPixels()) {
+		for (int y = 0; y < _atlas.h; ++y)
+			memcpy(newAtlas.getBasePtr(0, y), _atlas.getBasePtr(0, y), _atlas.w);
+		_atlas.free();
+	}
+
+	_atlas = newAtlas;
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping) {
@@ -153,6 +153,50 @@ bool ManagedSurface::clip(Common::Rect &srcBounds, Common::Rect &destBounds) {
 	return true;
 }
 
+/**
+ * Alpha blend a source pixel onto a destination pixel of a different format.
+ * Returns false if the source pixel is completely transparent, in which
+ * case the destination is to be left alone.
+ */
+static inline bool blendPixel(uint srcVal, uint &destVal, const PixelFormat &srcFormat, const PixelFormat &destFormat) {
+	byte aSrc, rSrc, gSrc, bSrc;
+	byte rDest, gDest, bDest;
+
+	srcFormat.colorToARGB(srcVal, aSrc, rSrc, gSrc, bSrc);
+	destFormat.colorToRGB(destVal, rDest, gDest, bDest);
+
+	if (aSrc == 0) {
+		// Completely transparent, so skip
+		return false;
+	} else if (aSrc == 0xff) {
+		// Completely opaque, so copy RGB values over
+		rDest = rSrc;
+		gDest = gSrc;
+		bDest = bSrc;
+	} else {
+		// Partially transparent, so calculate new pixel colors
+		double alpha = (double)aSrc / 255.0;
+		rDest = static_cast<byte>((rSrc * alpha) + (rDest * (1.0 - alpha)));
+		gDest = static_cast<byte>((gSrc * alpha) + (gDest * (1.0 - alpha)));
+		bDest = static_cast<byte>((bSrc * alpha) + (bDest * (1.0 - alpha)));
+	}
+
+	destVal = destFormat.ARGBToColor(0xff, rDest, gDest, bDest);
+	return true;
+}
+
+template<typename TSRC, typename TDEST>
+static void blendRow(const void *srcRow, void *destRow, int width, const PixelFormat &srcFormat, const PixelFormat &destFormat) {
+	const TSRC *srcP = (const TSRC *)srcRow;
+	TDEST *destP = (TDEST *)destRow;
+
+	for (int x = 0; x < width; ++x) {
+		uint destVal = destP[x];
+		if (blendPixel(srcP[x], destVal, srcFormat, destFormat))
+			destP[x] = destVal;
+	}
+}
+
 void ManagedSurface::blitFrom(const Surface &src) {
 	blitFrom(src, Common::Rect(0, 0, src.w, src.h), Common::Point(0, 0));
 }
@@ -166,59 +210,34 @@ void ManagedSurface::blitFrom(const Surface &src, const Common::Rect &srcRect,
 	Common::Rect srcBounds = srcRect;
 	Common::Rect destBounds(destPos.x, destPos.y, destPos.x + srcRect.width(),
 		destPos.y + srcRect.height());
-	uint destPixel;
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest, gDest, bDest;
-	double alpha;
 
 	if (!srcRect.isValidRect() || !clip(srcBounds, destBounds))
 		return;
 
-	if (format != src.format) {
+	if (src.format == format) {
+		// Matching surface formats, so we can do a straight copy
+		for (int y = 0; y < srcBounds.height(); ++y) {
+			const byte *srcP = (const byte *)src.getBasePtr(srcBounds.left, srcBounds.top + y);
+			byte *destP = (byte *)getBasePtr(destBounds.left, destBounds.top + y);
+			Common::copy(srcP, srcP + srcBounds.width() * format.bytesPerPixel, destP);
+		}
+	} else {
 		// When the pixel format differs, both source an dest must be
 		// 2 or 4 bytes per pixel
 		assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
 		assert(src.format.bytesPerPixel == 2 || src.format.bytesPerPixel == 4);
-	}
 
-	for (int y = 0; y < srcBounds.height(); ++y) {
-		const byte *srcP = (const byte *)src.getBasePtr(srcBounds.left, srcBounds.top + y);
-		byte *destP = (byte *)getBasePtr(destBounds.left, destBounds.top + y);
-
-		if (src.format == format) {
-			// Matching surface formats, so we can do a straight copy
-			Common::copy(srcP, srcP + srcBounds.width() * format.bytesPerPixel, destP);
-		} else {
-			for (int x = 0; x < srcBounds.width(); ++x,
-					srcP += src.format.bytesPerPixel,
-					destP += format.bytesPerPixel) {
-				src.format.colorToARGB(src.format.bytesPerPixel == 2 ? *(const uint16 *)srcP : *(const uint32 *)srcP,
-					aSrc, rSrc, gSrc, bSrc);
-				format.colorToRGB(format.bytesPerPixel == 2 ? *(const uint16 *)destP : *(const uint32 *)destP,
-					rDest, gDest, bDest);
-
-				if (aSrc == 0) {
-					// Completely transparent, so skip
-					continue;
-				} else if (aSrc == 0xff) {
-					// Completely opaque, so copy RGB values over
-					rDest = rSrc;
-					gDest = gSrc;
-					bDest = bSrc;
-				} else {
-					// Partially transparent, so calculate new pixel colors
-					alpha = (double)aSrc / 255.0;
-					rDest = static_cast<byte>((rSrc * alpha) + (rDest * (1.0 - alpha)));
-					gDest = static_cast<byte>((gSrc * alpha) + (gDest * (1.0 - alpha)));
-					bDest = static_cast<byte>((bSrc * alpha) + (bDest * (1.0 - alpha)));
-				}
-
-				destPixel = format.ARGBToColor(0xff, rDest, gDest, bDest);
-				if (format.bytesPerPixel == 2)
-					*(uint16 *)destP = destPixel;
-				else
-					*(uint32 *)destP = destPixel;
-			}
+		// Pick the row converter once, rather than checking the pixel
+		// sizes for every pixel
+		void (*blitRow)(const void *, void *, int, const PixelFormat &, const PixelFormat &);
+		if (src.format.bytesPerPixel == 2)
+			blitRow = (format.bytesPerPixel == 2) ? blendRow<uint16, uint16> : blendRow<uint16, uint32>;
+		else
+			blitRow = (format.bytesPerPixel == 2) ? blendRow<uint32, uint16> : blendRow<uint32, uint32>;
+
+		for (int y = 0; y < srcBounds.height(); ++y) {
+			blitRow(src.getBasePtr(srcBounds.left, srcBounds.top + y), getBasePtr(destBounds.left, destBounds.top + y),
+				srcBounds.width(), src.format, format);
 		}
 	}
 
@@ -242,60 +261,74 @@ void ManagedSurface::transBlitFrom(const Surface &src, const Common::Rect &srcRe
 		destPos.x + src.w, destPos.y + src.h), transColor, false, overrideColor);
 }
 
+/**
+ * Row kernels for transBlit, specialised on whether the pixel formats
+ * match, and whether the row is flipped or scaled. One of them is picked
+ * per call, so that the inner loops don't have to check these.
+ */
 template<typename TSRC, typename TDEST>
-void transBlit(const Surface &src, const Common::Rect &srcRect, Surface &dest, const Common::Rect &destRect, TSRC transColor, bool flipped, uint overrideColor) {
-	int scaleX = SCALE_THRESHOLD * srcRect.width() / destRect.width();
-	int scaleY = SCALE_THRESHOLD * srcRect.height() / destRect.height();
-	const Graphics::PixelFormat &srcFormat = src.format;
-	const Graphics::PixelFormat &destFormat = dest.format;
-	byte aSrc, rSrc, gSrc, bSrc;
-	byte rDest, gDest, bDest;
-	double alpha;
-
-	// Loop through drawing output lines
-	for (int destY = destRect.top, scaleYCtr = 0; destY < destRect.bottom; ++destY, scaleYCtr += scaleY) {
-		if (destY < 0 || destY >= dest.h)
-			continue;
-		const TSRC *srcLine = (const TSRC *)src.getBasePtr(srcRect.left, scaleYCtr / SCALE_THRESHOLD + srcRect.top);
-		TDEST *destLine = (TDEST *)dest.getBasePtr(destRect.left, destY);
-
-		// Loop through drawing the pixels of the row
-		for (int destX = destRect.left, xCtr = 0, scaleXCtr = 0; destX < destRect.right; ++destX, ++xCtr, scaleXCtr += scaleX) {
-			if (destX < 0 || destX >= dest.w)
-				continue;
-
-			TSRC srcVal = srcLine[flipped ? src.w - scaleXCtr / SCALE_THRESHOLD - 1 : scaleXCtr / SCALE_THRESHOLD];
+struct TransBlitRow {
+	typedef void (*Func)(const TSRC *srcLine, TDEST *destLine, int xStart, int xEnd, int scaleX, int srcW,
+		TSRC transColor, uint overrideColor, const PixelFormat &srcFormat, const PixelFormat &destFormat);
+
+	template<bool SAME_FORMAT, bool FLIPPED, bool SCALED>
+	static void blit(const TSRC *srcLine, TDEST *destLine, int xStart, int xEnd, int scaleX, int srcW,
+			TSRC transColor, uint overrideColor, const PixelFormat &srcFormat, const PixelFormat &destFormat) {
+		for (int xCtr = xStart, scaleXCtr = xStart * scaleX; xCtr < xEnd; ++xCtr, scaleXCtr += scaleX) {
+			const int srcX = SCALED ? scaleXCtr / SCALE_THRESHOLD : xCtr;
+			TSRC srcVal = srcLine[FLIPPED ? srcW - srcX - 1 : srcX];
 			if (srcVal == transColor)
 				continue;
 
-			if (srcFormat == destFormat) {
+			if (SAME_FORMAT) {
 				// Matching formats, so we can do a straight copy
 				destLine[xCtr] = overrideColor ? overrideColor : srcVal;
 			} else {
 				// Otherwise we have to manually decode and re-encode each pixel
-				srcFormat.colorToARGB(*srcLine, aSrc, rSrc, gSrc, bSrc);
-				destFormat.colorToRGB(destLine[xCtr], rDest, gDest, bDest);
-
-				if (aSrc == 0) {
-					// Completely transparent, so skip
-					continue;
-				} else if (aSrc == 0xff) {
-					// Completely opaque, so copy RGB values over
-					rDest = rSrc;
-					gDest = gSrc;
-					bDest = bSrc;
-				} else {
-					// Partially transparent, so calculate new pixel colors
-					alpha = (double)aSrc / 255.0;
-					rDest = static_cast<byte>((rSrc * alpha) + (rDest * (1.0 - alpha)));
-					gDest = static_cast<byte>((gSrc * alpha) + (gDest * (1.0 - alpha)));
-					bDest = static_cast<byte>((bSrc * alpha) + (bDest * (1.0 - alpha)));
-				}
-
-				destLine[xCtr] = destFormat.ARGBToColor(0xff, rDest, gDest, bDest);
+				uint destVal = destLine[xCtr];
+				if (blendPixel(srcVal, destVal, srcFormat, destFormat))
+					destLine[xCtr] = destVal;
 			}
 		}
 	}
+
+	template<bool SAME_FORMAT>
+	static Func select(bool flipped, bool scaled) {
+		if (flipped)
+			return scaled ? blit<SAME_FORMAT, true, true> : blit<SAME_FORMAT, true, false>;
+		else
+			return scaled ? blit<SAME_FORMAT, false, true> : blit<SAME_FORMAT, false, false>;
+	}
+
+	static Func select(bool sameFormat, bool flipped, bool scaled) {
+		return sameFormat ? select<true>(flipped, scaled) : select<false>(flipped, scaled);
+	}
+};
+
+template<typename TSRC, typename TDEST>
+void transBlit(const Surface &src, const Common::Rect &srcRect, Surface &dest, const Common::Rect &destRect, TSRC transColor, bool flipped, uint overrideColor) {
+	int scaleX = SCALE_THRESHOLD * srcRect.width() / destRect.width();
+	int scaleY = SCALE_THRESHOLD * srcRect.height() / destRect.height();
+
+	// Only draw the part of the destination rect which is on the surface
+	const int xStart = MAX<int>(0, -destRect.left);
+	const int xEnd = MIN<int>(destRect.width(), dest.w - destRect.left);
+	const int yStart = MAX<int>(destRect.top, 0);
+	const int yEnd = MIN<int>(destRect.bottom, dest.h);
+	if (xStart >= xEnd)
+		return;
+
+	typename TransBlitRow<TSRC, TDEST>::Func blitRow = TransBlitRow<TSRC, TDEST>::select(
+		src.format == dest.format, flipped, scaleX != SCALE_THRESHOLD);
+
+	// Loop through drawing output lines
+	for (int destY = yStart; destY < yEnd; ++destY) {
+		const int scaleYCtr = (destY - destRect.top) * scaleY;
+		const TSRC *srcLine = (const TSRC *)src.getBasePtr(srcRect.left, scaleYCtr / SCALE_THRESHOLD + srcRect.top);
+		TDEST *destLine = (TDEST *)dest.getBasePtr(destRect.left, destY);
+
+		blitRow(srcLine, destLine, xStart, xEnd, scaleX, src.w, transColor, overrideColor, src.format, dest.format);
+	}
 }
 
 #define HANDLE_BLIT(SRC_BYTES, DEST_BYTES, SRC_TYPE, DEST_TYPE) \
@@ -21,6 +21,7 @@
  */
 
 #include "graphics/scaler/intern.h"
+#include "common/util.h"
 
 #ifdef USE_NASM
 // Assembly version of HQ3x
@@ -99,6 +100,13 @@ void HQ3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 extern "C" uint32   *RGBtoYUV;
 #define YUV(x)	RGBtoYUV[w ## x]
 
+// Whether two of the neighbours differ, see hqxPatterns()
+#ifdef HQX_VECTOR_PATTERNS
+#define HQX_DIFF(a, b)	(pattern & kHqxDiff ## a ## b)
+#else
+#define HQX_DIFF(a, b)	diffYUV(YUV(a), YUV(b))
+#endif
+
 /*
  * The HQ3x high quality 3x graphics filter.
  * Original author Maxim Stepin (see http://www.hiend3d.com/hq3x.html).
@@ -115,6 +123,10 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	const uint32 nextlineDst2 = 2 * nextlineDst;
 	uint16 *q = (uint16 *)dstPtr;
 
+#ifdef HQX_VECTOR_PATTERNS
+	uint16 patterns[kHqxMaxPatterns];
+#endif
+
 	//	 +----+----+----+
 	//	 |    |    |    |
 	//	 | w1 | w2 | w3 |
@@ -136,13 +148,26 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w8 = *(p + nextlineSrc);
 
 		int tmpWidth = width;
+#ifdef HQX_VECTOR_PATTERNS
+		const uint16 *nextPattern = patterns + kHqxMaxPatterns;
+#endif
 		while (tmpWidth--) {
+#ifdef HQX_VECTOR_PATTERNS
+			if (nextPattern == patterns + kHqxMaxPatterns) {
+				hqxPatterns(p, nextlineSrc, MIN<int>(tmpWidth + 1, kHqxMaxPatterns), patterns);
+				nextPattern = patterns;
+			}
+#endif
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
+#ifdef HQX_VECTOR_PATTERNS
+			const int pattern = *nextPattern++;
+#else
 			int pattern = 0;
 			const int yuv5 = YUV(5);
 			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
@@ -153,8 +178,9 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
 			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
 			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+#endif
 
-			switch (pattern) {
+			switch (pattern & 0xFF) {
 			case 0:
 			case 1:
 			case 4:
@@ -352,7 +378,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 18:
 			case 50:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_1M
 					PIXEL12_C
@@ -375,7 +401,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_1M
@@ -392,7 +418,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_2
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_1M
 					PIXEL21_C
@@ -405,7 +431,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 10:
 			case 138:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 					PIXEL01_C
 					PIXEL10_C
@@ -498,7 +524,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 22:
 			case 54:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -521,7 +547,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -538,7 +564,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_2
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -551,7 +577,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 11:
 			case 139:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -569,7 +595,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 19:
 			case 51:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL00_1L
 					PIXEL01_C
 					PIXEL02_1M
@@ -588,7 +614,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 146:
 			case 178:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_1M
 					PIXEL12_C
@@ -607,7 +633,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 84:
 			case 85:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL02_1U
 					PIXEL12_C
 					PIXEL21_C
@@ -626,7 +652,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 112:
 			case 113:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL20_1L
 					PIXEL21_C
@@ -645,7 +671,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 200:
 			case 204:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_1M
 					PIXEL21_C
@@ -664,7 +690,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 73:
 			case 77:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL00_1U
 					PIXEL10_C
 					PIXEL20_1M
@@ -683,7 +709,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 42:
 			case 170:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 					PIXEL01_C
 					PIXEL10_C
@@ -702,7 +728,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 14:
 			case 142:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 					PIXEL01_C
 					PIXEL02_1R
@@ -809,7 +835,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 26:
 			case 31:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
@@ -817,7 +843,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL10_3
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -832,7 +858,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 82:
 			case 214:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -843,7 +869,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL12_C
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -857,7 +883,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL01_1
 				PIXEL02_1M
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
@@ -865,7 +891,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -875,7 +901,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 74:
 			case 107:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -886,7 +912,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -896,7 +922,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 27:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -914,7 +940,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 86:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -936,7 +962,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -952,7 +978,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -965,7 +991,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 30:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -987,7 +1013,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1003,7 +1029,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1015,7 +1041,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 75:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1164,13 +1190,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 58:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1185,7 +1211,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 83:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1195,7 +1221,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1M
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1208,20 +1234,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 202:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -1231,7 +1257,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -1240,7 +1266,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 78:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -1250,7 +1276,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -1259,13 +1285,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 154:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1280,7 +1306,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 114:
 				PIXEL00_1M
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1290,7 +1316,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1303,26 +1329,26 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 90:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1330,13 +1356,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1344,7 +1370,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 55:
 			case 23:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL00_1L
 					PIXEL01_C
 					PIXEL02_C
@@ -1363,7 +1389,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 182:
 			case 150:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1382,7 +1408,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 213:
 			case 212:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL02_1U
 					PIXEL12_C
 					PIXEL21_C
@@ -1401,7 +1427,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 241:
 			case 240:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL20_1L
 					PIXEL21_C
@@ -1420,7 +1446,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 236:
 			case 232:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1439,7 +1465,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 109:
 			case 105:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL00_1U
 					PIXEL10_C
 					PIXEL20_C
@@ -1458,7 +1484,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 171:
 			case 43:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1477,7 +1503,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 143:
 			case 15:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL02_1R
@@ -1500,7 +1526,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1U
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1512,7 +1538,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 203:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1530,7 +1556,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 62:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1552,7 +1578,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1564,7 +1590,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 118:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1586,7 +1612,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1602,7 +1628,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1R
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1614,7 +1640,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 155:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1724,12 +1750,12 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1U
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1740,12 +1766,12 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 158:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1761,7 +1787,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 234:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -1770,7 +1796,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1784,7 +1810,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 242:
 				PIXEL00_1M
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1792,7 +1818,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1L
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1803,7 +1829,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 59:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1812,7 +1838,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL01_3
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1829,7 +1855,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1838,7 +1864,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 					PIXEL21_3
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1846,7 +1872,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 87:
 				PIXEL00_1L
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1859,14 +1885,14 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL20_1M
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 79:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1878,7 +1904,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1R
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -1887,20 +1913,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 122:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
 				}
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1909,19 +1935,19 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 					PIXEL21_3
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 94:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1932,38 +1958,38 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 218:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
 				}
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1974,7 +2000,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 91:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1983,20 +2009,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL01_3
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
 				}
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -2047,13 +2073,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 186:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -2068,7 +2094,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 115:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -2078,7 +2104,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -2091,20 +2117,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 206:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -2114,7 +2140,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -2130,7 +2156,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -2140,7 +2166,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 174:
 			case 46:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -2158,7 +2184,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 147:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -2180,7 +2206,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -2210,7 +2236,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 126:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -2220,7 +2246,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL12_3
 				}
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -2232,7 +2258,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 219:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -2244,7 +2270,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -2255,7 +2281,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 125:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL00_1U
 					PIXEL10_C
 					PIXEL20_C
@@ -2273,7 +2299,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 221:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL02_1U
 					PIXEL12_C
 					PIXEL21_C
@@ -2291,7 +2317,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL20_1M
 				break;
 			case 207:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL02_1R
@@ -2309,7 +2335,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 238:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -2327,7 +2353,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_1
 				break;
 			case 190:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -2345,7 +2371,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL21_1
 				break;
 			case 187:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -2363,7 +2389,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 243:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL20_1L
 					PIXEL21_C
@@ -2381,7 +2407,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				break;
 			case 119:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL00_1L
 					PIXEL01_C
 					PIXEL02_C
@@ -2406,7 +2432,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
@@ -2416,7 +2442,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 175:
 			case 47:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
@@ -2434,7 +2460,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 151:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2456,7 +2482,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
@@ -2467,7 +2493,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL01_C
 				PIXEL02_1M
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
@@ -2475,7 +2501,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -2484,7 +2510,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 123:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -2495,7 +2521,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -2505,7 +2531,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 95:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
@@ -2513,7 +2539,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL10_3
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -2527,7 +2553,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 222:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -2538,7 +2564,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL12_C
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -2552,7 +2578,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1U
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
@@ -2560,7 +2586,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
@@ -2572,13 +2598,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -2587,7 +2613,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 235:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -2598,7 +2624,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
@@ -2607,7 +2633,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 111:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
@@ -2617,7 +2643,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -2627,13 +2653,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 63:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -2647,7 +2673,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 159:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
@@ -2655,7 +2681,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL10_3
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2669,7 +2695,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 215:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2678,7 +2704,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL12_C
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -2688,7 +2714,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 246:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -2700,7 +2726,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
@@ -2708,7 +2734,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 254:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -2716,14 +2742,14 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL02_4
 				}
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
 					PIXEL10_3
 					PIXEL20_4
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -2740,20 +2766,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 251:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -2762,7 +2788,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				PIXEL02_1M
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -2771,7 +2797,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_2
 					PIXEL21_3
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -2780,7 +2806,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 239:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
@@ -2790,7 +2816,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
@@ -2799,7 +2825,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 127:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -2808,7 +2834,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL01_3
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -2816,7 +2842,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL12_3
 				}
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -2826,13 +2852,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 191:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2845,14 +2871,14 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 223:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
 					PIXEL00_4
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -2863,7 +2889,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -2874,7 +2900,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 247:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2884,20 +2910,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 255:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (HQX_DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (HQX_DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2905,13 +2931,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (HQX_DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (HQX_DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
@@ -0,0 +1,157 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/scaler/intern.h"
+
+#ifdef HQX_VECTOR_PATTERNS
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HQX_SSE2
+#else
+#include <arm_neon.h>
+#define HQX_NEON
+#endif
+
+extern "C" uint32 *RGBtoYUV;
+
+namespace {
+
+// The diffYUV() thresholds for the Y, U and V bytes of a YUV value. None of
+// the bytes can borrow from the next one when subtracting, so diffYUV() can
+// be done on each byte on its own.
+const uint32 kYUVThreshold = 0x00300706;
+
+#if defined(HQX_SSE2)
+
+/** Returns all bits set in the lanes where diffYUV() would return false. */
+inline __m128i similarYUV(__m128i yuv1, __m128i yuv2, __m128i threshold) {
+	const __m128i diff = _mm_or_si128(_mm_subs_epu8(yuv1, yuv2), _mm_subs_epu8(yuv2, yuv1));
+	return _mm_cmpeq_epi32(_mm_subs_epu8(diff, threshold), _mm_setzero_si128());
+}
+
+inline __m128i addPatternBit(__m128i pattern, __m128i yuv1, __m128i yuv2, __m128i threshold, int bit) {
+	return _mm_or_si128(pattern, _mm_andnot_si128(similarYUV(yuv1, yuv2, threshold), _mm_set1_epi32(bit)));
+}
+
+void computePatterns(const uint32 *above, const uint32 *center, const uint32 *below, int width, uint16 *patterns) {
+	const __m128i threshold = _mm_set1_epi32(kYUVThreshold);
+
+	for (int x = 0; x < width; x += 4) {
+		const __m128i w1 = _mm_loadu_si128((const __m128i *)(above + x));
+		const __m128i w2 = _mm_loadu_si128((const __m128i *)(above + x + 1));
+		const __m128i w3 = _mm_loadu_si128((const __m128i *)(above + x + 2));
+		const __m128i w4 = _mm_loadu_si128((const __m128i *)(center + x));
+		const __m128i w5 = _mm_loadu_si128((const __m128i *)(center + x + 1));
+		const __m128i w6 = _mm_loadu_si128((const __m128i *)(center + x + 2));
+		const __m128i w7 = _mm_loadu_si128((const __m128i *)(below + x));
+		const __m128i w8 = _mm_loadu_si128((const __m128i *)(below + x + 1));
+		const __m128i w9 = _mm_loadu_si128((const __m128i *)(below + x + 2));
+
+		__m128i pattern = _mm_setzero_si128();
+		pattern = addPatternBit(pattern, w5, w1, threshold, 0x0001);
+		pattern = addPatternBit(pattern, w5, w2, threshold, 0x0002);
+		pattern = addPatternBit(pattern, w5, w3, threshold, 0x0004);
+		pattern = addPatternBit(pattern, w5, w4, threshold, 0x0008);
+		pattern = addPatternBit(pattern, w5, w6, threshold, 0x0010);
+		pattern = addPatternBit(pattern, w5, w7, threshold, 0x0020);
+		pattern = addPatternBit(pattern, w5, w8, threshold, 0x0040);
+		pattern = addPatternBit(pattern, w5, w9, threshold, 0x0080);
+		pattern = addPatternBit(pattern, w4, w2, threshold, kHqxDiff42);
+		pattern = addPatternBit(pattern, w2, w6, threshold, kHqxDiff26);
+		pattern = addPatternBit(pattern, w8, w4, threshold, kHqxDiff84);
+		pattern = addPatternBit(pattern, w6, w8, threshold, kHqxDiff68);
+
+		_mm_storel_epi64((__m128i *)(patterns + x), _mm_packs_epi32(pattern, pattern));
+	}
+}
+
+#elif defined(HQX_NEON)
+
+/** Returns all bits set in the lanes where diffYUV() would return false. */
+inline uint32x4_t similarYUV(uint32x4_t yuv1, uint32x4_t yuv2, uint8x16_t threshold) {
+	const uint8x16_t diff = vabdq_u8(vreinterpretq_u8_u32(yuv1), vreinterpretq_u8_u32(yuv2));
+	return vceqq_u32(vreinterpretq_u32_u8(vqsubq_u8(diff, threshold)), vdupq_n_u32(0));
+}
+
+inline uint32x4_t addPatternBit(uint32x4_t pattern, uint32x4_t yuv1, uint32x4_t yuv2, uint8x16_t threshold, uint32 bit) {
+	return vorrq_u32(pattern, vbicq_u32(vdupq_n_u32(bit), similarYUV(yuv1, yuv2, threshold)));
+}
+
+void computePatterns(const uint32 *above, const uint32 *center, const uint32 *below, int width, uint16 *patterns) {
+	const uint8x16_t threshold = vreinterpretq_u8_u32(vdupq_n_u32(kYUVThreshold));
+
+	for (int x = 0; x < width; x += 4) {
+		const uint32x4_t w1 = vld1q_u32(above + x);
+		const uint32x4_t w2 = vld1q_u32(above + x + 1);
+		const uint32x4_t w3 = vld1q_u32(above + x + 2);
+		const uint32x4_t w4 = vld1q_u32(center + x);
+		const uint32x4_t w5 = vld1q_u32(center + x + 1);
+		const uint32x4_t w6 = vld1q_u32(center + x + 2);
+		const uint32x4_t w7 = vld1q_u32(below + x);
+		const uint32x4_t w8 = vld1q_u32(below + x + 1);
+		const uint32x4_t w9 = vld1q_u32(below + x + 2);
+
+		uint32x4_t pattern = vdupq_n_u32(0);
+		pattern = addPatternBit(pattern, w5, w1, threshold, 0x0001);
+		pattern = addPatternBit(pattern, w5, w2, threshold, 0x0002);
+		pattern = addPatternBit(pattern, w5, w3, threshold, 0x0004);
+		pattern = addPatternBit(pattern, w5, w4, threshold, 0x0008);
+		pattern = addPatternBit(pattern, w5, w6, threshold, 0x0010);
+		pattern = addPatternBit(pattern, w5, w7, threshold, 0x0020);
+		pattern = addPatternBit(pattern, w5, w8, threshold, 0x0040);
+		pattern = addPatternBit(pattern, w5, w9, threshold, 0x0080);
+		pattern = addPatternBit(pattern, w4, w2, threshold, kHqxDiff42);
+		pattern = addPatternBit(pattern, w2, w6, threshold, kHqxDiff26);
+		pattern = addPatternBit(pattern, w8, w4, threshold, kHqxDiff84);
+		pattern = addPatternBit(pattern, w6, w8, threshold, kHqxDiff68);
+
+		vst1_u16(patterns + x, vmovn_u32(pattern));
+	}
+}
+
+#endif
+
+} // End of anonymous namespace
+
+void hqxPatterns(const uint16 *p, uint32 nextlineSrc, int width, uint16 *patterns) {
+	assert(width > 0 && width <= kHqxMaxPatterns);
+
+	// The YUV values of the rows above, at and below the pixels, from the
+	// left neighbour of the first pixel to the right neighbour of the last
+	// one. The vector loops work on groups of four pixels, and read values
+	// up to the end of the last group, which are cleared.
+	uint32 yuv[3][kHqxMaxPatterns + 2];
+	const uint16 *rows[3] = { p - nextlineSrc - 1, p - 1, p + nextlineSrc - 1 };
+	const int paddedWidth = (width + 3) & ~3;
+
+	for (int row = 0; row < 3; ++row) {
+		for (int x = 0; x < width + 2; ++x)
+			yuv[row][x] = RGBtoYUV[rows[row][x]];
+		for (int x = width + 2; x < paddedWidth + 2; ++x)
+			yuv[row][x] = 0;
+	}
+
+	computePatterns(yuv[0], yuv[1], yuv[2], width, patterns);
+}
+
+#endif
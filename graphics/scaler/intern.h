@@ -218,4 +218,36 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 */
 }
 
+#if defined(USE_HQ_SCALERS) && !defined(USE_NASM) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+
+// Let the hq scalers compute the patterns of a row with vector instructions
+#define HQX_VECTOR_PATTERNS
+
+/**
+ * Flags set by hqxPatterns() in addition to the eight bits of the hq
+ * pattern, telling whether two of the neighbours differ from each other.
+ */
+enum {
+	kHqxDiff42 = 0x0100,
+	kHqxDiff26 = 0x0200,
+	kHqxDiff84 = 0x0400,
+	kHqxDiff68 = 0x0800
+};
+
+/** Maximum number of pixels hqxPatterns() handles in one call. */
+enum { kHqxMaxPatterns = 64 };
+
+/**
+ * Computes the hq pattern of width pixels of a row, starting at p, at once.
+ * Bit n of the pattern is set when the (n + 1)th neighbour (w1 to w9,
+ * skipping w5) differs from the pixel according to diffYUV(). Used by the
+ * hq scaler family.
+ *
+ * @param patterns	buffer for the patterns, with room for kHqxMaxPatterns
+ *			values even if width is less
+ */
+extern void hqxPatterns(const uint16 *p, uint32 nextlineSrc, int width, uint16 *patterns);
+
+#endif
+
 #endif
@@ -22,82 +22,326 @@
 
 #include "common/system.h"
 #include "common/algorithm.h"
+#include "common/debug.h"
 #include "graphics/screen.h"
 #include "graphics/palette.h"
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+DirtyTileGrid::DirtyTileGrid() : _width(0), _height(0), _tilesW(0), _tilesH(0), _rowWords(0), _exact(true) {
+}
+
+void DirtyTileGrid::resize(int width, int height) {
+	_width = MAX(width, 0);
+	_height = MAX(height, 0);
+	_tilesW = (_width + kTileSize - 1) >> kTileShift;
+	_tilesH = (_height + kTileSize - 1) >> kTileShift;
+	_rowWords = (_tilesW + 31) >> 5;
+	_tiles.resize(_rowWords * _tilesH);
+	Common::fill(_tiles.begin(), _tiles.end(), 0);
+	_extents.resize(_tilesW * _tilesH);
+	resetExtents(0, 0, _tilesW - 1, _tilesH - 1);
+	_bounds = Common::Rect();
+	_rects.resize(0);
+	_exact = true;
+}
+
+void DirtyTileGrid::resetExtents(int tileLeft, int tileTop, int tileRight, int tileBottom) {
+	TileExtent clean;
+	clean.left = clean.top = kTileSize;
+	clean.right = clean.bottom = 0;
+	for (int ty = tileTop; ty <= tileBottom; ++ty)
+		Common::fill(&_extents[ty * _tilesW + tileLeft], &_extents[ty * _tilesW] + tileRight + 1, clean);
+}
+
+void DirtyTileGrid::addRect(const Common::Rect &r) {
+	Common::Rect area = r;
+	area.clip(Common::Rect(_width, _height));
+	if (area.isEmpty())
+		return;
+
+	if (_bounds.isEmpty())
+		_bounds = area;
+	else
+		_bounds.extend(area);
+
+	// Keep the areas themselves while there are few enough to merge directly
+	if (_exact) {
+		if (_rects.size() < kMaxRects)
+			_rects.push_back(area);
+		else
+			_exact = false;
+	}
+
+	const int tileLeft = area.left >> kTileShift;
+	const int tileRight = (area.right - 1) >> kTileShift;
+	const int tileTop = area.top >> kTileShift;
+	const int tileBottom = (area.bottom - 1) >> kTileShift;
+	const int wordLeft = tileLeft >> 5;
+	const int wordRight = tileRight >> 5;
+
+	// Only the outermost rows and columns of tiles can be partly covered
+	const byte left = area.left & (kTileSize - 1);
+	const byte top = area.top & (kTileSize - 1);
+	const byte right = area.right - (tileRight << kTileShift);
+	const byte bottom = area.bottom - (tileBottom << kTileShift);
+	for (int ty = tileTop; ty <= tileBottom; ++ty) {
+		TileExtent *extent = &_extents[ty * _tilesW + tileLeft];
+		for (int tx = tileLeft; tx <= tileRight; ++tx, ++extent) {
+			extent->left = MIN<byte>(extent->left, tx == tileLeft ? left : 0);
+			extent->top = MIN<byte>(extent->top, ty == tileTop ? top : 0);
+			extent->right = MAX<byte>(extent->right, tx == tileRight ? right : (byte)kTileSize);
+			extent->bottom = MAX<byte>(extent->bottom, ty == tileBottom ? bottom : (byte)kTileSize);
+		}
+	}
+
+	// Set the bits of the covered tiles a whole word at a time
+	for (int ty = tileTop; ty <= tileBottom; ++ty) {
+		uint32 *row = &_tiles[ty * _rowWords];
+		for (int word = wordLeft; word <= wordRight; ++word) {
+			uint32 mask = 0xFFFFFFFF;
+			if (word == wordLeft)
+				mask &= 0xFFFFFFFF << (tileLeft & 31);
+			if (word == wordRight)
+				mask &= 0xFFFFFFFF >> (31 - (tileRight & 31));
+			row[word] |= mask;
+		}
+	}
+}
+
+void DirtyTileGrid::clear() {
+	if (_bounds.isEmpty())
+		return;
+
+	// Only the tiles inside the bounds can have been marked
+	const int tileLeft = _bounds.left >> kTileShift;
+	const int tileRight = (_bounds.right - 1) >> kTileShift;
+	const int tileTop = _bounds.top >> kTileShift;
+	const int tileBottom = (_bounds.bottom - 1) >> kTileShift;
+	Common::fill(&_tiles[tileTop * _rowWords], &_tiles[0] + (tileBottom + 1) * _rowWords, 0);
+	resetExtents(tileLeft, tileTop, tileRight, tileBottom);
+	_bounds = Common::Rect();
+	_rects.resize(0);
+	_exact = true;
+}
+
+uint DirtyTileGrid::getRects(Common::Array<Common::Rect> &rects, uint maxRects) const {
+	// Rects are trivially destructible, so shrinking keeps the storage for
+	// the next frame
+	rects.resize(0);
+	if (_bounds.isEmpty())
+		return 0;
+
+	// A few areas are merged directly, which copies no more than was marked
+	// unless they overlap
+	if (_exact && _rects.size() <= maxRects) {
+		rects.push_back(_rects);
+		mergeOverlapping(rects);
+		return 0;
+	}
+
+	// Bridge ever larger gaps between runs until the list is short enough
+	uint tilesScanned = buildRects(rects, 0);
+	for (int maxGap = 1; rects.size() > maxRects; maxGap *= 2) {
+		rects.resize(0);
+		if (maxGap >= _tilesW) {
+			rects.push_back(_bounds);
+			break;
+		}
+
+		tilesScanned += buildRects(rects, maxGap);
+	}
+
+	return tilesScanned;
+}
+
+namespace {
+
+struct RectTopLess {
+	bool operator()(const Common::Rect &a, const Common::Rect &b) const {
+		return a.top < b.top;
+	}
+};
+
+} // End of anonymous namespace
+
+void DirtyTileGrid::mergeOverlapping(Common::Array<Common::Rect> &rects) {
+	// A rect that grows may overlap one that was already checked, so repeat
+	// until a pass finds nothing to merge
+	bool merged = true;
+	while (merged) {
+		merged = false;
+
+		// With the rects sorted by top, only the ones starting above the
+		// bottom of a rect can overlap it
+		Common::sort(rects.begin(), rects.end(), RectTopLess());
+		for (uint outer = 0; outer < rects.size(); ++outer) {
+			for (uint inner = outer + 1; inner < rects.size() && rects[inner].top < rects[outer].bottom; ++inner) {
+				if (!rects[outer].intersects(rects[inner]))
+					continue;
+
+				// Merge the rects, and check the grown one against the rest again
+				rects[outer].extend(rects[inner]);
+				rects.remove_at(inner);
+				inner = outer;
+				merged = true;
+			}
+		}
+	}
+}
+
+uint DirtyTileGrid::buildRects(Common::Array<Common::Rect> &rects, int maxGap) const {
+	const int tileLeft = _bounds.left >> kTileShift;
+	const int tileRight = (_bounds.right - 1) >> kTileShift;
+	const int tileTop = _bounds.top >> kTileShift;
+	const int tileBottom = (_bounds.bottom - 1) >> kTileShift;
+
+	// Rectangles, in tile units, that reach the previous row and may still
+	// grow downwards. The two lists swap roles on every row, and both are
+	// sorted left to right.
+	Common::Array<Common::Rect> openLists[2];
+	uint tilesScanned = 0;
+
+	for (int ty = tileTop; ty <= tileBottom; ++ty) {
+		const uint32 *row = &_tiles[ty * _rowWords];
+		const Common::Array<Common::Rect> &open = openLists[ty & 1];
+		Common::Array<Common::Rect> &nextOpen = openLists[(ty + 1) & 1];
+		uint openIdx = 0;
+		nextOpen.resize(0);
+
+		int tx = tileLeft;
+		while (tx <= tileRight) {
+			// Skip over empty tiles, a whole word at a time where possible
+			if (!(tx & 31) && !row[tx >> 5]) {
+				tx += 32;
+				tilesScanned += 32;
+				continue;
+			}
+			++tilesScanned;
+			if (!isTileDirty(row, tx)) {
+				++tx;
+				continue;
+			}
+
+			// Find the end of the run, carrying on over up to maxGap clean tiles
+			const int runLeft = tx;
+			int runRight = tx + 1;
+			for (int x = runRight; x <= tileRight && x <= runRight + maxGap; ++x) {
+				++tilesScanned;
+				if (isTileDirty(row, x))
+					runRight = x + 1;
+			}
+			tx = runRight + 1;
+
+			// Close any open rectangles that start before this run, and
+			// extend the one that matches it exactly
+			while (openIdx < open.size() && open[openIdx].left < runLeft)
+				emitRect(rects, open[openIdx++]);
+
+			if (openIdx < open.size() && open[openIdx].left == runLeft && open[openIdx].right == runRight) {
+				Common::Rect r = open[openIdx++];
+				r.bottom = ty + 1;
+				nextOpen.push_back(r);
+			} else {
+				nextOpen.push_back(Common::Rect(runLeft, ty, runRight, ty + 1));
+			}
+		}
+
+		while (openIdx < open.size())
+			emitRect(rects, open[openIdx++]);
+	}
+
+	const Common::Array<Common::Rect> &open = openLists[(tileBottom + 1) & 1];
+	for (uint i = 0; i < open.size(); ++i)
+		emitRect(rects, open[i]);
+
+	return tilesScanned;
+}
+
+void DirtyTileGrid::emitRect(Common::Array<Common::Rect> &rects, const Common::Rect &tiles) const {
+	// Clean tiles bridged over inside the rect have empty extents, so they
+	// don't affect the result
+	byte left = kTileSize, top = kTileSize, right = 0, bottom = 0;
+	for (int ty = tiles.top; ty < tiles.bottom; ++ty) {
+		left = MIN(left, _extents[ty * _tilesW + tiles.left].left);
+		right = MAX(right, _extents[ty * _tilesW + tiles.right - 1].right);
+	}
+	for (int tx = tiles.left; tx < tiles.right; ++tx) {
+		top = MIN(top, _extents[tiles.top * _tilesW + tx].top);
+		bottom = MAX(bottom, _extents[(tiles.bottom - 1) * _tilesW + tx].bottom);
+	}
+
+	rects.push_back(Common::Rect(
+		(tiles.left << kTileShift) + left,
+		(tiles.top << kTileShift) + top,
+		((tiles.right - 1) << kTileShift) + right,
+		((tiles.bottom - 1) << kTileShift) + bottom));
+}
+
+Screen::Screen(): ManagedSurface(), _rectsAdded(0) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
+	memset(&_stats, 0, sizeof(_stats));
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(), _rectsAdded(0) {
 	create(width, height);
+	memset(&_stats, 0, sizeof(_stats));
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(), _rectsAdded(0) {
 	create(width, height, pixelFormat);
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 void Screen::update() {
-	// Merge the dirty rects
-	mergeDirtyRects();
+	// Convert the dirty tiles to a list of rects
+	_stats._tilesScanned = _dirtyTiles.getRects(_dirtyRects);
+	_stats._rectsAdded = _rectsAdded;
+	_stats._rectsCopied = _dirtyRects.size();
+	_stats._pixelsCopied = 0;
 
 	// Loop through copying dirty areas to the physical screen
-	Common::List<Common::Rect>::iterator i;
-	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
-		const Common::Rect &r = *i;
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		const Common::Rect &r = _dirtyRects[i];
 		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
 		g_system->copyRectToScreen(srcP, pitch, r.left, r.top,
 			r.width(), r.height());
+		_stats._pixelsCopied += r.width() * r.height();
 	}
 
+	debug(5, "Screen::update: %d rects added, %d copied, %d pixels, %d tiles scanned",
+		_stats._rectsAdded, _stats._rectsCopied, _stats._pixelsCopied, _stats._tilesScanned);
+
 	// Signal the physical screen to update
 	g_system->updateScreen();
-	_dirtyRects.clear();
+	clearDirtyRects();
 }
 
+void Screen::clearDirtyRects() {
+	_dirtyTiles.clear();
+	_rectsAdded = 0;
+}
 
 void Screen::addDirtyRect(const Common::Rect &r) {
 	Common::Rect bounds = r;
 	bounds.clip(getBounds());
 	bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
 
-	if (bounds.width() > 0 && bounds.height() > 0)
-		_dirtyRects.push_back(bounds);
-}
-
-void Screen::makeAllDirty() {
-	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
-}
+	if (bounds.width() > 0 && bounds.height() > 0) {
+		// Keep the grid matching the size of the surface, which may have
+		// been recreated since the last frame
+		const int gridWidth = getOffsetFromOwner().x + this->w;
+		const int gridHeight = getOffsetFromOwner().y + this->h;
+		if (_dirtyTiles.getWidth() != gridWidth || _dirtyTiles.getHeight() != gridHeight)
+			_dirtyTiles.resize(gridWidth, gridHeight);
 
-void Screen::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
-
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
-
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
-
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
-
-				// move back to beginning of list
-				rInner = rOuter;
-			}
-		}
+		_dirtyTiles.addRect(bounds);
+		++_rectsAdded;
 	}
 }
 
-bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
-	destRect = src1;
-	destRect.extend(src2);
-
-	return !destRect.isEmpty();
+void Screen::makeAllDirty() {
+	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
 }
 
 void Screen::getPalette(byte palette[PALETTE_SIZE]) {
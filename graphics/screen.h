@@ -25,7 +25,7 @@
 
 #include "graphics/managed_surface.h"
 #include "graphics/pixelformat.h"
-#include "common/list.h"
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Graphics {
@@ -33,6 +33,123 @@ namespace Graphics {
 #define PALETTE_COUNT 256
 #define PALETTE_SIZE (256 * 3)
 
+/**
+ * Keeps track of the modified areas of a surface on a grid of fixed size
+ * tiles. Marking an area only sets the bits of the tiles it covers, so it
+ * costs the same however many areas have already been marked. The tiles are
+ * turned back into a list of rectangles once per frame, in a single pass
+ * over the grid. Frames with only a few marked areas skip the grid, and
+ * have their areas merged directly.
+ */
+class DirtyTileGrid {
+public:
+	enum {
+		kTileShift = 4,
+		kTileSize = 1 << kTileShift,
+		/** Default limit on the number of rectangles getRects returns */
+		kMaxRects = 128
+	};
+public:
+	DirtyTileGrid();
+
+	/**
+	 * Sets the size of the area being tracked, and clears all dirty tiles
+	 */
+	void resize(int width, int height);
+
+	int getWidth() const { return _width; }
+	int getHeight() const { return _height; }
+
+	/**
+	 * Marks the tiles covered by the given rectangle as dirty. The
+	 * rectangle is clipped to the tracked area.
+	 */
+	void addRect(const Common::Rect &r);
+
+	/**
+	 * Clears all dirty tiles
+	 */
+	void clear();
+
+	/**
+	 * Returns true if no tiles are dirty
+	 */
+	bool empty() const { return _bounds.isEmpty(); }
+
+	/**
+	 * Returns the smallest rectangle enclosing all the marked areas
+	 */
+	const Common::Rect &getBounds() const { return _bounds; }
+
+	/**
+	 * Converts the dirty tiles to a list of non-overlapping rectangles
+	 * covering all the marked areas. If no more than maxRects areas were
+	 * marked, they are merged where they overlap and returned without using
+	 * the tiles. Otherwise horizontal runs of dirty tiles are
+	 * joined with identical runs on the rows below them. If that yields
+	 * more than maxRects rectangles, runs separated by a few clean tiles are
+	 * joined as well, doubling the allowed gap until the list is short
+	 * enough. The bounding box is the last resort.
+	 *
+	 * @param rects		Receives the rectangles
+	 * @param maxRects	Maximum number of rectangles to return
+	 * @return			Number of tiles examined, which is 0 if the marked areas
+	 *					were merged directly
+	 */
+	uint getRects(Common::Array<Common::Rect> &rects, uint maxRects = kMaxRects) const;
+private:
+	/**
+	 * Merges overlapping rectangles until none of them overlap
+	 */
+	static void mergeOverlapping(Common::Array<Common::Rect> &rects);
+
+	/**
+	 * Builds the rectangle list, joining runs of dirty tiles on a row that
+	 * are separated by no more than maxGap clean tiles
+	 */
+	uint buildRects(Common::Array<Common::Rect> &rects, int maxGap) const;
+
+	/**
+	 * Adds a rectangle given in tile units, trimmed to the marked pixels of
+	 * its outermost tiles
+	 */
+	void emitRect(Common::Array<Common::Rect> &rects, const Common::Rect &tiles) const;
+
+	/**
+	 * Resets the marked areas of the given range of tiles
+	 */
+	void resetExtents(int tileLeft, int tileTop, int tileRight, int tileBottom);
+
+	bool isTileDirty(const uint32 *row, int tileX) const {
+		return (row[tileX >> 5] >> (tileX & 31)) & 1;
+	}
+private:
+	int _width, _height;
+	int _tilesW, _tilesH;
+	int _rowWords;
+	Common::Array<uint32> _tiles;
+	Common::Rect _bounds;
+
+	/**
+	 * The area marked within a single tile, relative to its top left corner
+	 */
+	struct TileExtent {
+		byte left, top, right, bottom;
+	};
+
+	/**
+	 * The area marked within each tile, used to trim the returned
+	 * rectangles to less than a tile
+	 */
+	Common::Array<TileExtent> _extents;
+
+	/**
+	 * The marked areas, kept until there are more than kMaxRects of them
+	 */
+	Common::Array<Common::Rect> _rects;
+	bool _exact;
+};
+
 /**
  * Implements a specialised surface that represents the screen.
  * It keeps track of any areas of itself that are updated by drawing
@@ -42,19 +159,27 @@ namespace Graphics {
 class Screen : public ManagedSurface {
 private:
 	/**
-	 * List of affected areas of the screen
+	 * Affected areas of the screen
 	 */
-	Common::List<Common::Rect> _dirtyRects;
-private:
-	/**
-	* Merges together overlapping dirty areas of the screen
-	*/
-	void mergeDirtyRects();
+	DirtyTileGrid _dirtyTiles;
 
 	/**
-	* Returns the union of two dirty area rectangles
-	*/
-	bool unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2);
+	 * Rectangles copied to the physical screen by the last update
+	 */
+	Common::Array<Common::Rect> _dirtyRects;
+public:
+	/**
+	 * Statistics on the dirty rect handling of a single update
+	 */
+	struct DirtyStats {
+		uint _rectsAdded;		///< Number of dirty rects added during the frame
+		uint _rectsCopied;		///< Number of rects copied to the physical screen
+		uint _pixelsCopied;		///< Number of pixels copied to the physical screen
+		uint _tilesScanned;		///< Number of grid tiles examined to build the rects
+	};
+private:
+	DirtyStats _stats;
+	uint _rectsAdded;
 protected:
 	/**
 	 * Adds a rectangle to the list of modified areas of the screen during the
@@ -69,7 +194,7 @@ public:
 	/**
 	 * Returns true if there are any pending screen updates (dirty areas)
 	 */
-	bool isDirty() const { return !_dirtyRects.empty(); }
+	bool isDirty() const { return !_dirtyTiles.empty(); }
 
 	/**
 	 * Marks the whole screen as dirty. This forces the next call to update
@@ -80,7 +205,12 @@ public:
 	/**
 	 * Clear the current dirty rects list
 	 */
-	virtual void clearDirtyRects() { _dirtyRects.clear(); }
+	virtual void clearDirtyRects();
+
+	/**
+	 * Returns statistics on the dirty areas copied by the most recent update
+	 */
+	const DirtyStats &getDirtyStats() const { return _stats; }
 
 	/**
 	 * Updates the screen by copying any affected areas to the system
@@ -37,6 +37,11 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+#if defined(__SSE2__) && defined(SCUMM_LITTLE_ENDIAN)
+#include <emmintrin.h>
+#define TRANSPARENT_SURFACE_SSE2
+#endif
+
 namespace Graphics {
 
 static const int kBModShift = 0;//img->format.bShift;
@@ -63,6 +68,7 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
+void doBlit(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color, TSpriteBlendMode blendMode, AlphaType alphaMode);
 
 TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL) {}
 
@@ -129,6 +135,181 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	}
 }
 
+#ifdef TRANSPARENT_SURFACE_SSE2
+
+/*
+ * SSE2 versions of the blend loops. Each blender works on two pixels,
+ * unpacked to 16 bits per channel, so that the lanes are laid out as
+ * A, B, G, R, A, B, G, R. They compute exactly the same results as the
+ * scalar loops below.
+ */
+
+struct BlendConstantsSSE2 {
+	__m128i ca;      ///< alpha modulation, in all lanes
+	__m128i tint;    ///< colour modulation per channel
+	__m128i tint256; ///< colour modulation, with 255 replaced by 256
+
+	BlendConstantsSSE2(uint32 color) {
+		int a = (color >> kAModShift) & 0xFF;
+		int r = (color >> kRModShift) & 0xFF;
+		int g = (color >> kGModShift) & 0xFF;
+		int b = (color >> kBModShift) & 0xFF;
+
+		ca = _mm_set1_epi16(a);
+		tint = _mm_set_epi16(r, g, b, a, r, g, b, a);
+
+		// The scalar code skips the colour modulation for channels at 255,
+		// shifting by 8 bits less. Multiplying by 256 instead of 255 and
+		// taking the high word has the same effect.
+		r = (r == 255) ? 256 : r;
+		g = (g == 255) ? 256 : g;
+		b = (b == 255) ? 256 : b;
+		tint256 = _mm_set_epi16(r, g, b, 0, r, g, b, 0);
+	}
+};
+
+static inline __m128i alphaLanesSSE2() {
+	return _mm_set_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+}
+
+static inline __m128i selectSSE2(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i broadcastAlphaSSE2(__m128i in) {
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(in, 0), 0);
+}
+
+static inline __m128i modulatedAlphaSSE2(__m128i in, const BlendConstantsSSE2 &c) {
+	return _mm_srli_epi16(_mm_mullo_epi16(broadcastAlphaSSE2(in), c.ca), 8);
+}
+
+struct AlphaBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &) {
+		const __m128i a = broadcastAlphaSSE2(in);
+		const __m128i ff = _mm_set1_epi16(255);
+		__m128i res = _mm_add_epi16(_mm_mullo_epi16(in, a), _mm_mullo_epi16(out, _mm_sub_epi16(ff, a)));
+		res = selectSSE2(alphaLanesSSE2(), ff, _mm_srli_epi16(res, 8));
+		return selectSSE2(_mm_cmpeq_epi16(a, _mm_setzero_si128()), out, res);
+	}
+};
+
+struct AlphaBlendTintSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &c) {
+		const __m128i ina = modulatedAlphaSSE2(in, c);
+		const __m128i ff = _mm_set1_epi16(255);
+		const __m128i dst = _mm_srli_epi16(_mm_mullo_epi16(out, _mm_sub_epi16(ff, ina)), 8);
+		const __m128i src = _mm_mulhi_epu16(_mm_mullo_epi16(in, ina), c.tint);
+		// The scalar code stores the sum in a byte, so it wraps around
+		const __m128i res = _mm_and_si128(_mm_add_epi16(dst, src), ff);
+		return selectSSE2(alphaLanesSSE2(), ff, res);
+	}
+};
+
+struct AdditiveBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &) {
+		const __m128i a = broadcastAlphaSSE2(in);
+		const __m128i res = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(in, a), 8), out);
+		return selectSSE2(_mm_or_si128(alphaLanesSSE2(), _mm_cmpeq_epi16(a, _mm_setzero_si128())), out, res);
+	}
+};
+
+struct AdditiveBlendTintSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &c) {
+		const __m128i ina = modulatedAlphaSSE2(in, c);
+		const __m128i res = _mm_add_epi16(out, _mm_mulhi_epu16(_mm_mullo_epi16(in, ina), c.tint256));
+		return selectSSE2(alphaLanesSSE2(), out, res);
+	}
+};
+
+struct SubtractiveBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &) {
+		const __m128i a = broadcastAlphaSSE2(in);
+		const __m128i res = _mm_sub_epi16(out, _mm_mulhi_epu16(_mm_mullo_epi16(in, out), a));
+		return selectSSE2(alphaLanesSSE2(), out, res);
+	}
+};
+
+struct SubtractiveBlendTintSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &c) {
+		const __m128i k = _mm_mullo_epi16(broadcastAlphaSSE2(in), c.tint256);
+		const __m128i res = _mm_sub_epi16(out, _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(in, out), k), 8));
+		return selectSSE2(alphaLanesSSE2(), _mm_set1_epi16(255), res);
+	}
+};
+
+struct MultiplyBlendSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &) {
+		const __m128i a = broadcastAlphaSSE2(in);
+		const __m128i src = _mm_srli_epi16(_mm_mullo_epi16(in, a), 8);
+		const __m128i res = _mm_srli_epi16(_mm_mullo_epi16(src, out), 8);
+		return selectSSE2(_mm_or_si128(alphaLanesSSE2(), _mm_cmpeq_epi16(a, _mm_setzero_si128())), out, res);
+	}
+};
+
+struct MultiplyBlendTintSSE2 {
+	static inline __m128i blend(__m128i in, __m128i out, const BlendConstantsSSE2 &c) {
+		const __m128i ina = modulatedAlphaSSE2(in, c);
+		const __m128i src = _mm_mulhi_epu16(_mm_mullo_epi16(in, ina), c.tint256);
+		const __m128i res = _mm_srli_epi16(_mm_mullo_epi16(src, out), 8);
+		return selectSSE2(alphaLanesSSE2(), out, res);
+	}
+};
+
+template<class Blender>
+static void blendSSE2(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	const BlendConstantsSSE2 c(color);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (uint32 i = 0; i < height; i++) {
+		byte *in = ino;
+		byte *out = outo;
+		for (uint32 j = 0; j < width; j += 4) {
+			__m128i src;
+			if (inStep > 0) {
+				src = _mm_loadu_si128((const __m128i *)in);
+			} else {
+				// Horizontally flipped: load the four pixels backwards
+				src = _mm_loadu_si128((const __m128i *)(in - 12));
+				src = _mm_shuffle_epi32(src, _MM_SHUFFLE(0, 1, 2, 3));
+			}
+			const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+			const __m128i lo = Blender::blend(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), c);
+			const __m128i hi = Blender::blend(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), c);
+			_mm_storeu_si128((__m128i *)out, _mm_packus_epi16(lo, hi));
+
+			in += 4 * inStep;
+			out += 16;
+		}
+		outo += pitch;
+		ino += inoStep;
+	}
+}
+
+/**
+ * Blend as many pixels of each row as possible with SSE2, using Blender
+ * without and TintBlender with colour modulation. The pointers and the
+ * width are advanced to the pixels which are left for the scalar code.
+ */
+template<class Blender, class TintBlender>
+static void doBlitSSE2(byte *&ino, byte *&outo, uint32 &width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
+	const uint32 simdWidth = width & ~3;
+	if (!simdWidth || (inStep != 4 && inStep != -4))
+		return;
+
+	if (color == 0xffffffff)
+		blendSSE2<Blender>(ino, outo, simdWidth, height, pitch, inStep, inoStep, color);
+	else
+		blendSSE2<TintBlender>(ino, outo, simdWidth, height, pitch, inStep, inoStep, color);
+
+	ino += (int32)simdWidth * inStep;
+	outo += simdWidth * 4;
+	width -= simdWidth;
+}
+
+#endif // TRANSPARENT_SURFACE_SSE2
+
 /**
  * Optimized version of doBlit to be used with alpha blended blitting
  * @param ino a pointer to the input surface
@@ -144,6 +325,10 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	byte *in;
 	byte *out;
 
+#ifdef TRANSPARENT_SURFACE_SSE2
+	doBlitSSE2<AlphaBlendSSE2, AlphaBlendTintSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+#endif
+
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
@@ -202,6 +387,10 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 	byte *in;
 	byte *out;
 
+#ifdef TRANSPARENT_SURFACE_SSE2
+	doBlitSSE2<AdditiveBlendSSE2, AdditiveBlendTintSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+#endif
+
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
@@ -269,6 +458,10 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 	byte *in;
 	byte *out;
 
+#ifdef TRANSPARENT_SURFACE_SSE2
+	doBlitSSE2<SubtractiveBlendSSE2, SubtractiveBlendTintSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+#endif
+
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
@@ -301,19 +494,19 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 
 				out[kAIndex] = 255;
 				if (cb != 255) {
-					out[kBIndex] = MAX(out[kBIndex] - ((in[kBIndex] * cb  * (out[kBIndex]) * in[kAIndex]) >> 24), 0);
+					out[kBIndex] = MAX(out[kBIndex] - (int)((uint)(in[kBIndex] * cb * out[kBIndex]) * in[kAIndex] >> 24), 0);
 				} else {
 					out[kBIndex] = MAX(out[kBIndex] - (in[kBIndex] * (out[kBIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cg != 255) {
-					out[kGIndex] = MAX(out[kGIndex] - ((in[kGIndex] * cg  * (out[kGIndex]) * in[kAIndex]) >> 24), 0);
+					out[kGIndex] = MAX(out[kGIndex] - (int)((uint)(in[kGIndex] * cg * out[kGIndex]) * in[kAIndex] >> 24), 0);
 				} else {
 					out[kGIndex] = MAX(out[kGIndex] - (in[kGIndex] * (out[kGIndex]) * in[kAIndex] >> 16), 0);
 				}
 
 				if (cr != 255) {
-					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * cr * (out[kRIndex]) * in[kAIndex]) >> 24), 0);
+					out[kRIndex] = MAX(out[kRIndex] - (int)((uint)(in[kRIndex] * cr * out[kRIndex]) * in[kAIndex] >> 24), 0);
 				} else {
 					out[kRIndex] = MAX(out[kRIndex] - (in[kRIndex] * (out[kRIndex]) * in[kAIndex] >> 16), 0);
 				}
@@ -334,6 +527,10 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 	byte *in;
 	byte *out;
 
+#ifdef TRANSPARENT_SURFACE_SSE2
+	doBlitSSE2<MultiplyBlendSSE2, MultiplyBlendTintSSE2>(ino, outo, width, height, pitch, inStep, inoStep, color);
+#endif
+
 	if (color == 0xffffffff) {
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
@@ -393,6 +590,28 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 
 }
 
+/**
+ * Pick the blending loop for the given parameters and run it.
+ */
+void doBlit(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color, TSpriteBlendMode blendMode, AlphaType alphaMode) {
+	if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && alphaMode == ALPHA_OPAQUE) {
+		doBlitOpaqueFast(ino, outo, width, height, pitch, inStep, inoStep);
+	} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && alphaMode == ALPHA_BINARY) {
+		doBlitBinaryFast(ino, outo, width, height, pitch, inStep, inoStep);
+	} else {
+		if (blendMode == BLEND_ADDITIVE) {
+			doBlitAdditiveBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_SUBTRACTIVE) {
+			doBlitSubtractiveBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_MULTIPLY) {
+			doBlitMultiplyBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else {
+			assert(blendMode == BLEND_NORMAL);
+			doBlitAlphaBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		}
+	}
+}
+
 Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, TSpriteBlendMode blendMode) {
 
 	Common::Rect retSize;
@@ -453,17 +672,14 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 	height = height * 2 / 3;
 #endif
 
-	Graphics::Surface *img = nullptr;
-	Graphics::Surface *imgScaled = nullptr;
-	byte *savedPixels = nullptr;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
-	} else {
-		img = &srcImage;
+		// Scale the image while blending it, without creating a scaled copy
+		srcImage.setAlphaMode(_alphaMode);
+		return srcImage.blitScaled<FILTER_NEAREST>(target, Common::Rect(target.w, target.h), posX, posY, width, height, flipping, color, blendMode);
 	}
 
+	Graphics::Surface *img = &srcImage;
+
 	// Handle off-screen clipping
 	if (posY < 0) {
 		img->h = MAX(0, (int)img->h - -posY);
@@ -510,34 +726,13 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 		byte *ino = (byte *)img->getBasePtr(xp, yp);
 		byte *outo = (byte *)target.getBasePtr(posX, posY);
 
-		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else {
-			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else {
-				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			}
-		}
+		doBlit(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color, blendMode, _alphaMode);
 
 	}
 
 	retSize.setWidth(img->w);
 	retSize.setHeight(img->h);
 
-	if (imgScaled) {
-		imgScaled->setPixels(savedPixels);
-		imgScaled->free();
-		delete imgScaled;
-	}
-
 	return retSize;
 }
 
@@ -600,17 +795,14 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 	height = height * 2 / 3;
 #endif
 
-	Graphics::Surface *img = nullptr;
-	Graphics::Surface *imgScaled = nullptr;
-	byte *savedPixels = nullptr;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
-	} else {
-		img = &srcImage;
+		// Scale the image while blending it, without creating a scaled copy
+		srcImage.setAlphaMode(_alphaMode);
+		return srcImage.blitScaled<FILTER_NEAREST>(target, clippingArea, posX, posY, width, height, flipping, color, blendMode);
 	}
 
+	Graphics::Surface *img = &srcImage;
+
 	// Handle off-screen clipping
 	if (posY < clippingArea.top) {
 		img->h = MAX(0, (int)img->h - (clippingArea.top - posY));
@@ -657,34 +849,13 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 		byte *ino = (byte *)img->getBasePtr(xp, yp);
 		byte *outo = (byte *)target.getBasePtr(posX, posY);
 
-		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else {
-			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else {
-				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			}
-		}
+		doBlit(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color, blendMode, _alphaMode);
 
 	}
 
 	retSize.setWidth(img->w);
 	retSize.setHeight(img->h);
 
-	if (imgScaled) {
-		imgScaled->setPixels(savedPixels);
-		imgScaled->free();
-		delete imgScaled;
-	}
-
 	return retSize;
 }
 
@@ -1070,6 +1241,248 @@ TransparentSurface *TransparentSurface::scaleT(uint16 newWidth, uint16 newHeight
 	return target;
 }
 
+/*
+ * Samplers for blitScaled() and blitRotoscaled(). They compute a run of
+ * pixels of one row of the transformed image on demand, using the same
+ * fixed-point math as scaleT() and rotoscaleT() above, so that blending
+ * their output gives exactly the same result as blending a transformed
+ * copy of the surface.
+ */
+
+class ScaleNearestSampler {
+public:
+	ScaleNearestSampler(const TransparentSurface &src, int dstW, int dstH) :
+		_src(src), _dstW(dstW), _dstH(dstH),
+		_stepX(src.w / dstW), _stepRemX(src.w % dstW) {}
+
+	void sampleRow(tColorRGBA *dp, int x, int y, int n) const {
+		const tColorRGBA *sp = (const tColorRGBA *)_src.getBasePtr(0, (y * _src.h) / _dstH);
+
+		// Step through (x * w) / dstW incrementally
+		int sx = (x * _src.w) / _dstW;
+		int rem = (x * _src.w) % _dstW;
+		for (int i = 0; i < n; i++) {
+			*dp++ = sp[sx];
+			sx += _stepX;
+			rem += _stepRemX;
+			if (rem >= _dstW) {
+				rem -= _dstW;
+				sx++;
+			}
+		}
+	}
+
+private:
+	const TransparentSurface &_src;
+	int _dstW, _dstH;
+	int _stepX, _stepRemX;
+};
+
+static inline void interpolate(tColorRGBA *dp, const tColorRGBA *c00, const tColorRGBA *c01, const tColorRGBA *c10, const tColorRGBA *c11, int ex, int ey) {
+	int t1, t2;
+	t1 = ((((c01->r - c00->r) * ex) >> 16) + c00->r) & 0xff;
+	t2 = ((((c11->r - c10->r) * ex) >> 16) + c10->r) & 0xff;
+	dp->r = (((t2 - t1) * ey) >> 16) + t1;
+	t1 = ((((c01->g - c00->g) * ex) >> 16) + c00->g) & 0xff;
+	t2 = ((((c11->g - c10->g) * ex) >> 16) + c10->g) & 0xff;
+	dp->g = (((t2 - t1) * ey) >> 16) + t1;
+	t1 = ((((c01->b - c00->b) * ex) >> 16) + c00->b) & 0xff;
+	t2 = ((((c11->b - c10->b) * ex) >> 16) + c10->b) & 0xff;
+	dp->b = (((t2 - t1) * ey) >> 16) + t1;
+	t1 = ((((c01->a - c00->a) * ex) >> 16) + c00->a) & 0xff;
+	t2 = ((((c11->a - c10->a) * ex) >> 16) + c10->a) & 0xff;
+	dp->a = (((t2 - t1) * ey) >> 16) + t1;
+}
+
+class ScaleBilinearSampler {
+public:
+	ScaleBilinearSampler(const TransparentSurface &src, int dstW, int dstH) : _src(src) {
+		_spixelw = src.w - 1;
+		_spixelh = src.h - 1;
+		_sx = (dstW > 1) ? (int)(65536.0f * (float)_spixelw / (float)(dstW - 1)) : 0;
+		_sy = (dstH > 1) ? (int)(65536.0f * (float)_spixelh / (float)(dstH - 1)) : 0;
+		_ssx = (src.w << 16) - 1;
+		_ssy = (src.h << 16) - 1;
+	}
+
+	void sampleRow(tColorRGBA *dp, int x, int y, int n) const {
+		const int csy = (int)MIN<int64>((int64)y * _sy, _ssy);
+		const int cy = csy >> 16;
+		const int ey = csy & 0xffff;
+		const tColorRGBA *row0 = (const tColorRGBA *)_src.getBasePtr(0, cy);
+		const tColorRGBA *row1 = (cy < _spixelh) ? (const tColorRGBA *)_src.getBasePtr(0, cy + 1) : row0;
+
+		int csx = (int)MIN<int64>((int64)x * _sx, _ssx);
+		for (int i = 0; i < n; i++) {
+			const int cx = csx >> 16;
+			const int cx1 = (cx < _spixelw) ? cx + 1 : cx;
+			interpolate(dp++, &row0[cx], &row0[cx1], &row1[cx], &row1[cx1], csx & 0xffff, ey);
+
+			csx += _sx;
+			if (csx > _ssx)
+				csx = _ssx;
+		}
+	}
+
+private:
+	const TransparentSurface &_src;
+	int _spixelw, _spixelh;
+	int _sx, _sy;
+	int _ssx, _ssy;
+};
+
+template <TFilteringMode filteringMode>
+class RotoscaleSampler {
+public:
+	RotoscaleSampler(const TransparentSurface &src, const TransformStruct &transform, const Common::Point &newHotspot) : _src(src) {
+		_empty = (transform._zoom.x == 0 || transform._zoom.y == 0);
+		if (_empty)
+			return;
+
+		uint32 invAngle = 360 - (transform._angle % 360);
+		float invCos = cos(invAngle * M_PI / 180.0);
+		float invSin = sin(invAngle * M_PI / 180.0);
+
+		_icosx = (int)(invCos * (65536.0f * kDefaultZoomX / transform._zoom.x));
+		_isinx = (int)(invSin * (65536.0f * kDefaultZoomX / transform._zoom.x));
+		_icosy = (int)(invCos * (65536.0f * kDefaultZoomY / transform._zoom.y));
+		_isiny = (int)(invSin * (65536.0f * kDefaultZoomY / transform._zoom.y));
+
+		_xd = transform._hotspot.x << 16;
+		_yd = transform._hotspot.y << 16;
+		_cx = newHotspot.x;
+		_cy = newHotspot.y;
+		_ax = -_icosx * _cx;
+		_ay = -_isiny * _cx;
+	}
+
+	void sampleRow(tColorRGBA *dp, int x, int y, int n) const {
+		// Pixels outside of the source are transparent
+		memset(dp, 0, n * sizeof(tColorRGBA));
+		if (_empty)
+			return;
+
+		const byte *pixels = (const byte *)_src.getPixels();
+		const int pitch = _src.pitch;
+		const int srcW = _src.w;
+		const int srcH = _src.h;
+		const int sw = srcW - 1;
+		const int sh = srcH - 1;
+		const int t = _cy - y;
+		int sdx = _ax + (_isinx * t) + _xd + x * _icosx;
+		int sdy = _ay - (_icosy * t) + _yd + x * _isiny;
+
+		for (int i = 0; i < n; i++, dp++) {
+			const int dx = (sdx >> 16);
+			const int dy = (sdy >> 16);
+
+			if (filteringMode == FILTER_BILINEAR) {
+				if ((dx > -1) && (dy > -1) && (dx < sw) && (dy < sh)) {
+					const tColorRGBA *sp = (const tColorRGBA *)(pixels + dy * pitch) + dx;
+					const tColorRGBA *sp1 = (const tColorRGBA *)(pixels + (dy + 1) * pitch) + dx;
+					interpolate(dp, sp, sp + 1, sp1, sp1 + 1, sdx & 0xffff, sdy & 0xffff);
+				}
+			} else {
+				if ((dx >= 0) && (dy >= 0) && (dx < srcW) && (dy < srcH))
+					*dp = *((const tColorRGBA *)(pixels + dy * pitch) + dx);
+			}
+			sdx += _icosx;
+			sdy += _isiny;
+		}
+	}
+
+private:
+	const TransparentSurface &_src;
+	bool _empty;
+	int _icosx, _isinx, _icosy, _isiny;
+	int _xd, _yd;
+	int _cx, _cy;
+	int _ax, _ay;
+};
+
+/**
+ * Blend the dstW x dstH pixel image produced by sampler onto target at
+ * (posX, posY), clipped to clippingArea. The image is generated in short
+ * runs into a buffer on the stack, so no intermediate surface is needed.
+ */
+template <class Sampler>
+static Common::Rect blitSampled(Graphics::Surface &target, Common::Rect clippingArea, int posX, int posY, int dstW, int dstH, int flipping, uint color, TSpriteBlendMode blendMode, AlphaType alphaMode, const Sampler &sampler) {
+	clippingArea.clip(Common::Rect(target.w, target.h));
+
+	// The visible part of the image, relative to its top left corner
+	const int left = MAX<int>(clippingArea.left - posX, 0);
+	const int top = MAX<int>(clippingArea.top - posY, 0);
+	const int right = MIN<int>(clippingArea.right - posX, dstW);
+	const int bottom = MIN<int>(clippingArea.bottom - posY, dstH);
+
+	if (left >= right || top >= bottom)
+		return Common::Rect();
+
+	const int kChunkSize = 256;
+	tColorRGBA buffer[kChunkSize];
+
+	for (int y = top; y < bottom; y++) {
+		const int sy = (flipping & FLIP_V) ? dstH - 1 - y : y;
+		byte *outo = (byte *)target.getBasePtr(posX + left, posY + y);
+
+		for (int x = left; x < right; x += kChunkSize) {
+			const int n = MIN(kChunkSize, right - x);
+			byte *ino = (byte *)buffer;
+			int32 inStep = 4;
+
+			if (flipping & FLIP_H) {
+				// Sample the mirrored run and blend it backwards
+				sampler.sampleRow(buffer, dstW - x - n, sy, n);
+				ino += (n - 1) * 4;
+				inStep = -4;
+			} else {
+				sampler.sampleRow(buffer, x, sy, n);
+			}
+
+			doBlit(ino, outo, n, 1, target.pitch, inStep, 0, color, blendMode, alphaMode);
+			outo += n * 4;
+		}
+	}
+
+	return Common::Rect(right - left, bottom - top);
+}
+
+template <TFilteringMode filteringMode>
+Common::Rect TransparentSurface::blitScaled(Graphics::Surface &target, const Common::Rect &clippingArea, int posX, int posY, int newWidth, int newHeight, int flipping, uint color, TSpriteBlendMode blendMode) const {
+	if (format.bytesPerPixel != 4) {
+		warning("TransparentSurface can only blit 32bpp images, but got %d", format.bytesPerPixel * 8);
+		return Common::Rect();
+	}
+
+	if (((color >> kAModShift) & 0xff) == 0 || newWidth <= 0 || newHeight <= 0 || w == 0 || h == 0)
+		return Common::Rect();
+
+	if (filteringMode == FILTER_BILINEAR) {
+		return blitSampled(target, clippingArea, posX, posY, newWidth, newHeight, flipping, color, blendMode, _alphaMode,
+		                   ScaleBilinearSampler(*this, newWidth, newHeight));
+	} else {
+		return blitSampled(target, clippingArea, posX, posY, newWidth, newHeight, flipping, color, blendMode, _alphaMode,
+		                   ScaleNearestSampler(*this, newWidth, newHeight));
+	}
+}
+
+template <TFilteringMode filteringMode>
+Common::Rect TransparentSurface::blitRotoscaled(Graphics::Surface &target, const Common::Rect &clippingArea, int posX, int posY, const TransformStruct &transform, int flipping, uint color, TSpriteBlendMode blendMode) const {
+	if (format.bytesPerPixel != 4) {
+		warning("TransparentSurface can only blit 32bpp images, but got %d", format.bytesPerPixel * 8);
+		return Common::Rect();
+	}
+
+	if (((color >> kAModShift) & 0xff) == 0)
+		return Common::Rect();
+
+	Common::Point newHotspot;
+	Common::Rect rect = TransformTools::newRect(Common::Rect(0, 0, (int16)w, (int16)h), transform, &newHotspot);
+
+	return blitSampled(target, clippingArea, posX, posY, rect.width(), rect.height(), flipping, color, blendMode, _alphaMode,
+	                   RotoscaleSampler<filteringMode>(*this, transform, newHotspot));
+}
+
 TransparentSurface *TransparentSurface::convertTo(const PixelFormat &dstFormat, const byte *palette) const {
 	assert(pixels);
 
@@ -1164,6 +1577,11 @@ template TransparentSurface *TransparentSurface::rotoscaleT<FILTER_BILINEAR>(con
 template TransparentSurface *TransparentSurface::scaleT<FILTER_NEAREST>(uint16 newWidth, uint16 newHeight) const;
 template TransparentSurface *TransparentSurface::scaleT<FILTER_BILINEAR>(uint16 newWidth, uint16 newHeight) const;
 
+template Common::Rect TransparentSurface::blitScaled<FILTER_NEAREST>(Graphics::Surface &target, const Common::Rect &clippingArea, int posX, int posY, int newWidth, int newHeight, int flipping, uint color, TSpriteBlendMode blendMode) const;
+template Common::Rect TransparentSurface::blitScaled<FILTER_BILINEAR>(Graphics::Surface &target, const Common::Rect &clippingArea, int posX, int posY, int newWidth, int newHeight, int flipping, uint color, TSpriteBlendMode blendMode) const;
+template Common::Rect TransparentSurface::blitRotoscaled<FILTER_NEAREST>(Graphics::Surface &target, const Common::Rect &clippingArea, int posX, int posY, const TransformStruct &transform, int flipping, uint color, TSpriteBlendMode blendMode) const;
+template Common::Rect TransparentSurface::blitRotoscaled<FILTER_BILINEAR>(Graphics::Surface &target, const Common::Rect &clippingArea, int posX, int posY, const TransformStruct &transform, int flipping, uint color, TSpriteBlendMode blendMode) const;
+
 template void TransparentSurface::scaleNN<uint8>(int *scaleCacheX, TransparentSurface *target) const;
 template void TransparentSurface::scaleNN<uint16>(int *scaleCacheX, TransparentSurface *target) const;
 template void TransparentSurface::scaleNN<uint32>(int *scaleCacheX, TransparentSurface *target) const;
@@ -163,6 +163,42 @@ struct TransparentSurface : public Graphics::Surface {
 
 	TransparentSurface *rotoscale(const TransformStruct &transform) const;
 
+	/**
+	 * @brief Scale this surface and blend it onto the target in one go.
+	 *
+	 * This gives the same result as blitting the surface returned by
+	 * scaleT(newWidth, newHeight) with blitClip(), but it samples the
+	 * source directly into the target instead of creating a scaled copy.
+	 *
+	 * @param target the surface to blit to.
+	 * @param clippingArea the area of the target to limit drawing to.
+	 * @param posX, posY where to put the top left corner of the scaled image.
+	 * @param newWidth, newHeight the size of the scaled image.
+	 * @param flipping how to flip the scaled image, see blit().
+	 * @param color the color modulation, see blit().
+	 * @param blend the blend mode.
+	 * @return the size of the drawn area.
+	 */
+	template <TFilteringMode filteringMode>
+	Common::Rect blitScaled(Graphics::Surface &target, const Common::Rect &clippingArea,
+	                        int posX, int posY, int newWidth, int newHeight,
+	                        int flipping = FLIP_NONE,
+	                        uint color = TS_ARGB(255, 255, 255, 255),
+	                        TSpriteBlendMode blend = BLEND_NORMAL) const;
+
+	/**
+	 * @brief Rotate and scale this surface and blend it onto the target in
+	 * one go, like blitting the result of rotoscaleT(transform). The top
+	 * left corner of the bounding box of the transformed image is put at
+	 * (posX, posY). See blitScaled() for the other parameters.
+	 */
+	template <TFilteringMode filteringMode>
+	Common::Rect blitRotoscaled(Graphics::Surface &target, const Common::Rect &clippingArea,
+	                            int posX, int posY, const TransformStruct &transform,
+	                            int flipping = FLIP_NONE,
+	                            uint color = TS_ARGB(255, 255, 255, 255),
+	                            TSpriteBlendMode blend = BLEND_NORMAL) const;
+
 	TransparentSurface *convertTo(const PixelFormat &dstFormat, const byte *palette = 0) const;
 
 	float getRatio() {
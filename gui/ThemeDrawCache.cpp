@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "gui/ThemeDrawCache.h"
+
+namespace GUI {
+
+struct ThemeDrawCache::Entry {
+	Entry(const Key &key, const Common::Rect &region) : _key(key), _region(region) {}
+
+	~Entry() {
+		_background.free();
+		_result.free();
+	}
+
+	uint getSize() const {
+		return _background.h * _background.pitch + _result.h * _result.pitch;
+	}
+
+	Key _key;
+
+	/** The region of the surface the item was drawn to. */
+	Common::Rect _region;
+
+	Graphics::Surface _background;
+	Graphics::Surface _result;
+};
+
+namespace {
+
+void copySurfaceArea(Graphics::Surface &dst, const Graphics::Surface &src, int srcX, int srcY) {
+	const int lineSize = dst.w * dst.format.bytesPerPixel;
+	for (int y = 0; y < dst.h; ++y)
+		memcpy(dst.getBasePtr(0, y), src.getBasePtr(srcX, srcY + y), lineSize);
+}
+
+bool compareSurfaceArea(const Graphics::Surface &a, const Graphics::Surface &b, int bX, int bY) {
+	const int lineSize = a.w * a.format.bytesPerPixel;
+	for (int y = 0; y < a.h; ++y) {
+		if (memcmp(a.getBasePtr(0, y), b.getBasePtr(bX, bY + y), lineSize))
+			return false;
+	}
+	return true;
+}
+
+} // End of anonymous namespace
+
+ThemeDrawCache::Key::Key(const void *data, uint32 dynamic, const Common::Rect &area, const Common::Rect &region, bool clipped, bool shadows) :
+	_data(data), _dynamicData(dynamic), _areaWidth(area.width()), _areaHeight(area.height()),
+	_region(region), _oddLeft(area.left & 1), _clipped(clipped), _shadows(shadows) {
+	_region.translate(-area.left, -area.top);
+}
+
+bool ThemeDrawCache::Key::operator==(const Key &other) const {
+	return _data == other._data && _dynamicData == other._dynamicData &&
+	       _areaWidth == other._areaWidth && _areaHeight == other._areaHeight &&
+	       _region == other._region && _oddLeft == other._oddLeft &&
+	       _clipped == other._clipped && _shadows == other._shadows;
+}
+
+ThemeDrawCache::ThemeDrawCache() : _size(0), _limit(0) {
+}
+
+ThemeDrawCache::~ThemeDrawCache() {
+	clear();
+}
+
+void ThemeDrawCache::setLimit(uint limit) {
+	_limit = limit;
+	shrink();
+}
+
+bool ThemeDrawCache::fits(const Common::Rect &region, const Graphics::PixelFormat &format) const {
+	// An entry holds both the background and the rendering
+	const uint entrySize = 2 * (uint)region.width() * (uint)region.height() * format.bytesPerPixel;
+	return entrySize * 2 <= _limit;
+}
+
+bool ThemeDrawCache::restore(const Key &key, Graphics::Surface &surface, const Common::Rect &region) {
+	for (Common::List<Entry *>::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		Entry *entry = *i;
+		if (!(entry->_key == key))
+			continue;
+
+		if (!compareSurfaceArea(entry->_background, surface, region.left, region.top))
+			continue;
+
+		// Same item over the same background, so the drawing would give
+		// the same result again
+		surface.copyRectToSurface(entry->_result, region.left, region.top,
+			Common::Rect(entry->_result.w, entry->_result.h));
+
+		_entries.erase(i);
+		_entries.push_front(entry);
+		return true;
+	}
+
+	return false;
+}
+
+ThemeDrawCache::Entry *ThemeDrawCache::startEntry(const Key &key, const Graphics::Surface &surface, const Common::Rect &region) {
+	Entry *entry = new Entry(key, region);
+	entry->_background.create(region.width(), region.height(), surface.format);
+	copySurfaceArea(entry->_background, surface, region.left, region.top);
+	return entry;
+}
+
+void ThemeDrawCache::finishEntry(Entry *entry, const Graphics::Surface &surface) {
+	entry->_result.create(entry->_region.width(), entry->_region.height(), surface.format);
+	copySurfaceArea(entry->_result, surface, entry->_region.left, entry->_region.top);
+
+	_entries.push_front(entry);
+	_size += entry->getSize();
+	shrink();
+}
+
+void ThemeDrawCache::clear() {
+	for (Common::List<Entry *>::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete *i;
+
+	_entries.clear();
+	_size = 0;
+}
+
+void ThemeDrawCache::shrink() {
+	// Drop the least recently used renderings
+	while (_size > _limit) {
+		Entry *last = _entries.back();
+		_size -= last->getSize();
+		delete last;
+		_entries.pop_back();
+	}
+}
+
+} // End of namespace GUI
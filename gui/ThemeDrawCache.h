@@ -0,0 +1,134 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GUI_THEME_DRAW_CACHE_H
+#define GUI_THEME_DRAW_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/list.h"
+#include "common/rect.h"
+
+#include "graphics/surface.h"
+
+namespace GUI {
+
+/**
+ * A least recently used cache of renderings of theme DrawData items.
+ *
+ * Draw steps blend with what is already on the surface (anti-aliased
+ * edges, shadows), so each rendering is stored together with the
+ * background it was drawn over, and is only reused when that matches
+ * exactly.
+ */
+class ThemeDrawCache {
+public:
+	/**
+	 * Everything apart from the background which decides what drawing
+	 * an item gives.
+	 */
+	struct Key {
+		/**
+		 * @param data      the item being drawn
+		 * @param dynamic   dynamic data passed to the draw steps
+		 * @param area      the area the item is drawn in
+		 * @param region    the part of the surface which is drawn to
+		 * @param clipped   whether the item is drawn with clipping
+		 * @param shadows   whether the renderer draws shadows
+		 */
+		Key(const void *data, uint32 dynamic, const Common::Rect &area, const Common::Rect &region, bool clipped, bool shadows);
+
+		bool operator==(const Key &other) const;
+
+		const void *_data;
+		uint32 _dynamicData;
+		int16 _areaWidth, _areaHeight;
+
+		/** The region, relative to the area. */
+		Common::Rect _region;
+
+		/**
+		 * Dithered gradients alternate their colors between even and odd
+		 * columns of the surface, so the parity of the area position
+		 * changes the rendering.
+		 */
+		bool _oddLeft;
+
+		bool _clipped;
+		bool _shadows;
+	};
+
+	struct Entry;
+
+	ThemeDrawCache();
+	~ThemeDrawCache();
+
+	/**
+	 * Set the number of bytes the pixels of the cached renderings may
+	 * use, dropping the least recently used ones to fit.
+	 */
+	void setLimit(uint limit);
+
+	/**
+	 * Check whether a rendering of a region is small enough to be cached.
+	 * A single rendering may use at most half of the limit.
+	 */
+	bool fits(const Common::Rect &region, const Graphics::PixelFormat &format) const;
+
+	/**
+	 * Look for a rendering of an item over the current contents of the
+	 * region of a surface, and copy it there if there is one.
+	 *
+	 * @return whether a cached rendering was used
+	 */
+	bool restore(const Key &key, Graphics::Surface &surface, const Common::Rect &region);
+
+	/**
+	 * Start caching a new rendering, saving the region of the surface as
+	 * the background it is drawn over. Must be followed by a call to
+	 * finishEntry once the item is drawn.
+	 */
+	Entry *startEntry(const Key &key, const Graphics::Surface &surface, const Common::Rect &region);
+
+	/**
+	 * Add an entry to the cache, saving its region of the surface as the
+	 * rendering.
+	 */
+	void finishEntry(Entry *entry, const Graphics::Surface &surface);
+
+	/** Drop all cached renderings. */
+	void clear();
+
+private:
+	void shrink();
+
+	/** Cached renderings, most recently used first. */
+	Common::List<Entry *> _entries;
+
+	/** Number of bytes used by the pixels in _entries. */
+	uint _size;
+
+	uint _limit;
+};
+
+} // End of namespace GUI
+
+#endif
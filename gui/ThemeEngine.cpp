@@ -91,6 +91,11 @@ struct WidgetDrawData {
 
 	bool _buffer;
 
+	/** Set by the theme to cache this DrawData even if it is cheap to draw */
+	bool _cached;
+
+	/** Whether renderings of this DrawData may be cached, @see ThemeEngine::drawDD */
+	bool _cacheable;
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -100,6 +105,13 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Decides whether renderings of this DrawData item can be cached. Like
+	 * calcBackgroundOffset, this must be called once all the DrawSteps have
+	 * been loaded.
+	 */
+	void calcCacheable();
 };
 
 class ThemeItem {
@@ -280,11 +292,8 @@ void ThemeItemDrawData::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step)
-			_engine->renderer()->drawStep(_area, *step, _dynamicData);
-	}
+	if (draw)
+		_engine->drawDD(_data, _area, extendedRect, 0, _dynamicData);
 
 	_engine->addDirtyRect(extendedRect);
 }
@@ -301,12 +310,8 @@ void ThemeItemDrawDataClip::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step) {
-			_engine->renderer()->drawStepClip(_area, _clip, *step, _dynamicData);
-		}
-	}
+	if (draw)
+		_engine->drawDD(_data, _area, extendedRect, &_clip, _dynamicData);
 
 	extendedRect.clip(_clip);
 
@@ -648,6 +653,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
 
+	// Cached renderings were made for the old surfaces and renderer
+	_drawDataCache.clear();
+
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
 	// list. Clearing it avoids invalid overlay writes when the backend
@@ -670,12 +678,81 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_shadowOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheable() {
+	_cacheable = false;
+
+	// Draw steps take the colors they do not set from whatever was drawn
+	// before, so each color a step uses must be set by it or by an earlier
+	// step of the same DrawData. Filling the whole surface and drawing
+	// bitmaps can reach outside of the widget area, and are cheap anyway.
+	bool fgSet = false, bgSet = false, gradientSet = false, bevelSet = false;
+	bool expensive = _cached;
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE ||
+		    step->drawingCall == &Graphics::VectorRenderer::drawCallback_BITMAP ||
+		    step->drawingCall == &Graphics::VectorRenderer::drawCallback_ALPHABITMAP)
+			return;
+
+		fgSet |= step->fgColor.set;
+		bgSet |= step->bgColor.set;
+		gradientSet |= (step->gradColor1.set && step->gradColor2.set && step->factor > 0);
+		bevelSet |= step->bevelColor.set;
+
+		if (!fgSet)
+			return;
+		if (step->fillMode == Graphics::VectorRenderer::kFillBackground && !bgSet)
+			return;
+		if (step->fillMode == Graphics::VectorRenderer::kFillGradient && !gradientSet)
+			return;
+		if (step->bevel && !bevelSet)
+			return;
+
+		if (step->fillMode == Graphics::VectorRenderer::kFillGradient || step->shadow || step->bevel)
+			expensive = true;
+	}
+
+	_cacheable = expensive;
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	r.clip(_screen.w, _screen.h);
 	_vectorRenderer->blitSurface(&_backBuffer, r);
 }
 
+void ThemeEngine::drawDD(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &region,
+                         const Common::Rect *clip, uint32 dynamic) {
+	Graphics::TransparentSurface *surface = _vectorRenderer->getActiveSurface();
+
+	Common::Rect cachedRegion = region;
+	cachedRegion.clip(surface->w, surface->h);
+	if (clip)
+		cachedRegion.clip(*clip);
 
+	// Keep up to two screens worth of renderings
+	_drawDataCache.setLimit(2 * _screen.h * _screen.pitch);
+	const bool cacheable = data->_cacheable && !cachedRegion.isEmpty() && _drawDataCache.fits(cachedRegion, surface->format);
+
+	const ThemeDrawCache::Key key(data, dynamic, area, cachedRegion, clip != 0, _vectorRenderer->areShadowsEnabled());
+	if (cacheable && _drawDataCache.restore(key, *surface, cachedRegion))
+		return;
+
+	ThemeDrawCache::Entry *entry = 0;
+	if (cacheable)
+		entry = _drawDataCache.startEntry(key, *surface, cachedRegion);
+
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	for (step = data->_steps.begin(); step != data->_steps.end(); ++step) {
+		if (clip)
+			_vectorRenderer->drawStepClip(area, *clip, *step, dynamic);
+		else
+			_vectorRenderer->drawStep(area, *step, dynamic);
+	}
+
+	if (entry)
+		_drawDataCache.finishEntry(entry, *surface);
+}
 
 /**********************************************************
  * Theme elements management
@@ -872,6 +949,8 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_buffer = kDrawDataDefaults[id].buffer;
+	_widgets[id]->_cached = cached;
+	_widgets[id]->_cacheable = false;
 	_widgets[id]->_textDataId = kTextDataNone;
 
 	return true;
@@ -903,11 +982,15 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s'", kDrawDataDefaults[i].name);
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheable();
 		}
 	}
 }
 
 void ThemeEngine::unloadTheme() {
+	// The cache refers to the DrawData of the theme
+	_drawDataCache.clear();
+
 	if (!_themeOk)
 		return;
 
@@ -36,6 +36,8 @@
 #include "graphics/font.h"
 #include "graphics/pixelformat.h"
 
+#include "gui/ThemeDrawCache.h"
+
 
 #define SCUMMVM_THEME_VERSION_STR "SCUMMVM_STX0.8.23"
 
@@ -466,7 +468,8 @@ public:
 	 * for that given set.
 	 *
 	 * @param data The representing DrawData name, as found on Theme Description XML files.
-	 * @param cached Whether this DD set will be cached beforehand.
+	 * @param cached Whether renderings of this DD set are always cached. Sets
+	 *               with gradients, shadows or bevels are cached regardless.
 	 */
 	bool addDrawData(const Common::String &data, bool cached);
 
@@ -581,6 +584,21 @@ public:
 	 */
 	void restoreBackground(Common::Rect r);
 
+	/**
+	 * Draws all the steps of a DrawData set. When the set is cacheable, the
+	 * result is kept, and drawn again by copying it whenever the set is
+	 * drawn with the same size and dynamic data over the same background.
+	 * @see ThemeDrawCache
+	 *
+	 * @param data    DrawData set to draw.
+	 * @param area    Area of the widget.
+	 * @param region  Area the steps may draw to, which is what is cached.
+	 * @param clip    Clipping area, or 0 to draw without clipping.
+	 * @param dynamic Dynamic data passed to the draw steps.
+	 */
+	void drawDD(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &region,
+	            const Common::Rect *clip, uint32 dynamic);
+
 	const Common::String &getThemeName() const { return _themeName; }
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
@@ -715,6 +733,9 @@ protected:
 	 */
 	WidgetDrawData *_widgets[kDrawDataMAX];
 
+	/** Cached renderings of DrawData sets. */
+	ThemeDrawCache _drawDataCache;
+
 	/** Array of all the text fonts that can be drawn. */
 	TextDrawData *_texts[kTextDataMAX];
 
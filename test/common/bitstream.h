@@ -3,6 +3,8 @@
 #include "common/bitstream.h"
 #include "common/memstream.h"
 
+#include "helper.h"
+
 class BitStreamTestSuite : public CxxTest::TestSuite
 {
 private:
@@ -211,4 +213,49 @@ public:
 		tmpl_peek_bits_lsb<Common::MemoryReadStream, Common::BitStream8LSB>();
 		tmpl_peek_bits_lsb<Common::BitStreamMemoryStream, Common::BitStreamMemory8LSB>();
 	}
+
+private:
+	template<class MS, class BS>
+	void tmpl_peek_skip_matches_get() {
+		// Peeks and skips across several data values have to agree with
+		// reading the same bits with getBits()
+		byte contents[64];
+		TestRandom rnd;
+		for (uint i = 0; i < sizeof(contents); ++i)
+			contents[i] = rnd.next() >> 16;
+
+		MS ms1(contents, sizeof(contents));
+		MS ms2(contents, sizeof(contents));
+		BS peeking(ms1);
+		BS reading(ms2);
+
+		while (reading.size() - reading.pos() >= 64) {
+			const uint8 n = (rnd.next() >> 16) % 33;
+			const uint32 skip = (rnd.next() >> 16) % 33;
+
+			const uint32 expected = reading.getBits(n);
+			TS_ASSERT_EQUALS(peeking.peekBits(n), expected);
+			peeking.skip(n);
+			TS_ASSERT_EQUALS(peeking.pos(), reading.pos());
+
+			uint8 buffered = n;
+			const uint32 bufferedBits = peeking.peekBufferedBits(buffered);
+			TS_ASSERT(buffered <= n);
+			if (buffered)
+				TS_ASSERT_EQUALS(bufferedBits, peeking.peekBits(buffered));
+
+			reading.getBits(skip);
+			peeking.skip(skip);
+			TS_ASSERT_EQUALS(peeking.pos(), reading.pos());
+		}
+	}
+public:
+	void test_peek_skip_matches_get() {
+		tmpl_peek_skip_matches_get<Common::MemoryReadStream, Common::BitStream8MSB>();
+		tmpl_peek_skip_matches_get<Common::MemoryReadStream, Common::BitStream8LSB>();
+		tmpl_peek_skip_matches_get<Common::MemoryReadStream, Common::BitStream16LEMSB>();
+		tmpl_peek_skip_matches_get<Common::MemoryReadStream, Common::BitStream32BELSB>();
+		tmpl_peek_skip_matches_get<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>();
+		tmpl_peek_skip_matches_get<Common::BitStreamMemoryStream, Common::BitStreamMemory32LEMSB>();
+	}
 };
@@ -1,8 +1,17 @@
 #include <cxxtest/TestSuite.h>
 
 #include "common/hashmap.h"
+#include "common/flat-hashmap.h"
 #include "common/hash-str.h"
 
+#include "helper.h"
+
+// Puts all keys into the last slot of the initial FlatHashMap table: the top
+// four bits of this value times the Fibonacci multiplier are all set.
+struct LastSlotHash {
+	uint operator()(int) const { return 0x70000000; }
+};
+
 class HashMapTestSuite : public CxxTest::TestSuite
 {
 	public:
@@ -230,5 +239,141 @@ class HashMapTestSuite : public CxxTest::TestSuite
 		TS_ASSERT(found == 16+8+4);
 }
 
+	void test_flat_collision() {
+		// All keys share the last slot of the initial table, so their
+		// cluster wraps around to the start.
+		Common::FlatHashMap<int, int, LastSlotHash> h;
+		h[15] = 1;
+		h[31] = 2;
+		h[47] = 3;
+		h[0] = 4;
+		TS_ASSERT_EQUALS(h.size(), 4U);
+		TS_ASSERT_EQUALS(h[15], 1);
+		TS_ASSERT_EQUALS(h[31], 2);
+		TS_ASSERT_EQUALS(h[47], 3);
+		TS_ASSERT_EQUALS(h[0], 4);
+		h.erase(15);
+		TS_ASSERT(!h.contains(15));
+		TS_ASSERT_EQUALS(h[31], 2);
+		TS_ASSERT_EQUALS(h[47], 3);
+		TS_ASSERT_EQUALS(h[0], 4);
+		h.erase(h.find(31));
+		TS_ASSERT_EQUALS(h[47], 3);
+		TS_ASSERT_EQUALS(h[0], 4);
+		h[15] = 5;
+		TS_ASSERT_EQUALS(h[15], 5);
+		TS_ASSERT_EQUALS(h.size(), 3U);
+
+		const Common::FlatHashMap<int, int, LastSlotHash> &constRef = h;
+		TS_ASSERT_EQUALS(constRef.getVal(31), 0);
+		TS_ASSERT_EQUALS(constRef.getVal(31, -10), -10);
+		TS_ASSERT_EQUALS(constRef.size(), 3U);
+		TS_ASSERT(constRef.find(31) == constRef.end());
+	}
+
+	void test_flat_erase_iterating() {
+		typedef Common::FlatHashMap<int, int, LastSlotHash> CollidingMap;
+		CollidingMap h;
+		for (int i = 0; i < 64; ++i)
+			h[i] = i;
+
+		// Erase the even keys; the odd ones have to be visited exactly once
+		int visited = 0;
+		for (CollidingMap::iterator i = h.begin(); i != h.end(); ) {
+			visited++;
+			if (i->_key % 2 == 0)
+				i = h.erase(i);
+			else
+				++i;
+		}
+		TS_ASSERT_EQUALS(visited, 64);
+		TS_ASSERT_EQUALS(h.size(), 32U);
+		for (int i = 0; i < 64; ++i)
+			TS_ASSERT_EQUALS(h.contains(i), i % 2 != 0);
+
+		for (CollidingMap::iterator i = h.begin(); i != h.end(); )
+			i = h.erase(i);
+		TS_ASSERT(h.empty());
+		TS_ASSERT(h.begin() == h.end());
+	}
+
+	void test_flat_shared_low_bits() {
+		// Integers hash to themselves, so these keys only differ in bits
+		// above any table size reached here
+		Common::FlatHashMap<uint32, int> h;
+		for (int i = 0; i < 300; ++i)
+			h[(uint32)i << 23] = i;
+		TS_ASSERT_EQUALS(h.size(), 300U);
+		for (int i = 0; i < 300; ++i)
+			TS_ASSERT_EQUALS(h[(uint32)i << 23], i);
+	}
+
+	void test_flat_string_keys() {
+		typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatStringMap;
+		FlatStringMap map1;
+		map1["Foo"] = "bar";
+		map1["quux"] = "blub";
+		TS_ASSERT(map1.contains("FOO"));
+		TS_ASSERT_EQUALS(map1["foo"], "bar");
+
+		FlatStringMap map2(map1);
+		map2["QUUX"] = "changed";
+		TS_ASSERT_EQUALS(map1["quux"], "blub");
+		TS_ASSERT_EQUALS(map2["quux"], "changed");
+
+		int found = 0;
+		for (FlatStringMap::const_iterator i = map2.begin(); i != map2.end(); ++i) {
+			if (i->_key == "Foo")
+				found |= 1;
+			else if (i->_key == "quux")
+				found |= 2;
+		}
+		TS_ASSERT_EQUALS(found, 3);
+
+		map1 = map2;
+		TS_ASSERT_EQUALS(map1["quux"], "changed");
+		map1.clear(true);
+		TS_ASSERT(map1.empty());
+		TS_ASSERT(map1.begin() == map1.end());
+		TS_ASSERT_EQUALS(map2.size(), 2U);
+	}
+
+	void test_flat_matches_hashmap() {
+		// Run the same mixed workload of String keyed inserts, lookups and
+		// erases, as done by the config manager and engine symbol tables,
+		// on both map types and check that they always agree.
+		Common::HashMap<Common::String, int> reference;
+		Common::FlatHashMap<Common::String, int> flat;
+
+		TestRandom rnd;
+		for (int i = 0; i < 40000; ++i) {
+			const uint32 r = rnd.next() >> 8;
+			const Common::String key = Common::String::format("section%d/key_%u", r % 7, r % 5000);
+
+			switch ((r >> 16) % 4) {
+			case 0:
+			case 1:
+				reference[key] = i;
+				flat[key] = i;
+				break;
+			case 2:
+				reference.erase(key);
+				flat.erase(key);
+				break;
+			default:
+				TS_ASSERT_EQUALS(flat.contains(key), reference.contains(key));
+				break;
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		uint matching = 0;
+		for (Common::FlatHashMap<Common::String, int>::const_iterator i = flat.begin(); i != flat.end(); ++i) {
+			if (reference.contains(i->_key) && reference[i->_key] == i->_value)
+				matching++;
+		}
+		TS_ASSERT_EQUALS(matching, reference.size());
+	}
+
 	// TODO: Add test cases for iterators, find, ...
 };
@@ -0,0 +1,31 @@
+#ifndef TEST_COMMON_HELPER_H
+#define TEST_COMMON_HELPER_H
+
+#include "common/scummsys.h"
+
+/**
+ * A small linear congruential generator for tests which need a lot of
+ * input data. Unlike Common::RandomSource it does not depend on g_system,
+ * and the sequence for a given seed is fixed, so that tests can compare
+ * against precomputed results.
+ */
+class TestRandom {
+public:
+	explicit TestRandom(uint32 seed = 1) : _seed(seed) {}
+
+	void setSeed(uint32 seed) { _seed = seed; }
+
+	/**
+	 * Advance the generator and return its whole state. The lower bits
+	 * have short periods, so callers should use the upper ones.
+	 */
+	uint32 next() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed;
+	}
+
+private:
+	uint32 _seed;
+};
+
+#endif
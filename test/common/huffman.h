@@ -3,6 +3,8 @@
 #include "common/bitstream.h"
 #include "common/memstream.h"
 
+#include "helper.h"
+
 /**
 * A test suite for the Huffman decoder in common/huffman.h
 * The encoding used comes from the example on the Wikipedia page
@@ -141,4 +143,136 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	void test_get_symbols_batch() {
+
+		/*
+		 * Same encoding as in test_get_with_full_symbols, but all
+		 * symbols are decoded with a single call. With a lookup width
+		 * of 3, the leading 11 00 and 00 00 pairs are each decoded by
+		 * one lookup.
+		 */
+
+		uint32 codeCount = 5;
+		uint8 maxLength = 3;
+		const uint8 lengths[] = {3,3,2,2,2};
+		const uint32 codes[]  = {0x2, 0x3, 0x3, 0x0, 0x2};
+		const uint32 symbols[]  = {0xA, 0xB, 0xC, 0xD, 0xE};
+
+		Common::Huffman h(maxLength, codeCount, codes, lengths, symbols);
+
+		byte input[] = {0x4F, 0x20};
+		uint32 expected[] = {0xA, 0xB, 0xC, 0xD, 0xE, 0xD, 0xD};
+		uint32 output[7];
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		Common::BitStream8MSB bs(ms);
+
+		h.getSymbols(bs, output, 7);
+
+		for (int i = 0; i < 7; i++)
+			TS_ASSERT_EQUALS(output[i], expected[i]);
+	}
+
+	void test_lookup_tables_msb() {
+		checkLookupTables(true);
+	}
+
+	void test_lookup_tables_lsb() {
+		checkLookupTables(false);
+	}
+
+	private:
+	enum {
+		kCodeCount = 16,
+		kSymbolCount = 20000
+	};
+
+	/**
+	 * Decode a long random message with codes of 1 to 15 bits, using
+	 * the bitwise search as well as different lookup table widths, so
+	 * that primary tables, secondary tables and the bitwise fallback
+	 * all get exercised on the same data.
+	 */
+	void checkLookupTables(bool msb) {
+		uint8 lengths[kCodeCount];
+		uint32 codes[kCodeCount];
+		uint32 symbols[kCodeCount];
+
+		// Canonical code with the lengths 1, 2, ..., 15, 15
+		uint32 code = 0;
+		for (int i = 0; i < kCodeCount; i++) {
+			lengths[i] = MIN(i + 1, kCodeCount - 1);
+			if (i > 0)
+				code = (code + 1) << (lengths[i] - lengths[i - 1]);
+
+			codes[i] = msb ? code : reverseBits(code, lengths[i]);
+			symbols[i] = 0x100 + i;
+		}
+
+		// Encode a random message
+		Common::Array<uint32> message;
+		Common::Array<byte> data;
+		uint32 bitPos = 0;
+		TestRandom rnd(12345);
+
+		for (int i = 0; i < kSymbolCount; i++) {
+			uint32 index = (rnd.next() >> 16) % kCodeCount;
+			message.push_back(symbols[index]);
+
+			for (int bit = 0; bit < lengths[index]; bit++, bitPos++) {
+				if ((bitPos & 7) == 0)
+					data.push_back(0);
+
+				uint32 value = msb ? (codes[index] >> (lengths[index] - 1 - bit)) & 1 : (codes[index] >> bit) & 1;
+				if (value)
+					data[bitPos >> 3] |= msb ? (0x80 >> (bitPos & 7)) : (1 << (bitPos & 7));
+			}
+		}
+
+		const uint8 lookupBits[] = { 0, 4, 9, 15 };
+
+		for (int i = 0; i < ARRAYSIZE(lookupBits); i++) {
+			Common::Huffman h(0, kCodeCount, codes, lengths, symbols, lookupBits[i]);
+
+			TS_ASSERT(decodeMessage(h, data, msb, false) == message);
+			TS_ASSERT(decodeMessage(h, data, msb, true) == message);
+		}
+	}
+
+	static uint32 reverseBits(uint32 value, uint8 length) {
+		uint32 result = 0;
+
+		for (int i = 0; i < length; i++)
+			result |= ((value >> i) & 1) << (length - 1 - i);
+
+		return result;
+	}
+
+	static Common::Array<uint32> decodeMessage(const Common::Huffman &h, const Common::Array<byte> &data, bool msb, bool batch) {
+		Common::Array<uint32> result;
+		result.resize(kSymbolCount);
+
+		Common::MemoryReadStream ms(data.begin(), data.size());
+
+		if (msb) {
+			Common::BitStream8MSB bs(ms);
+			decodeSymbols(h, bs, result, batch);
+		} else {
+			Common::BitStream8LSB bs(ms);
+			decodeSymbols(h, bs, result, batch);
+		}
+
+		return result;
+	}
+
+	template<class BITSTREAM>
+	static void decodeSymbols(const Common::Huffman &h, BITSTREAM &bs, Common::Array<uint32> &result, bool batch) {
+		if (batch) {
+			h.getSymbols(bs, result.begin(), result.size());
+		} else {
+			for (uint i = 0; i < result.size(); i++)
+				result[i] = h.getSymbol(bs);
+		}
+	}
 };
@@ -0,0 +1,47 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/interned-str.h"
+
+class InternedStringTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_identity() {
+		const Common::InternedString a("Data/Intro.smk");
+		const Common::InternedString b("DATA/intro.SMK");
+		const Common::InternedString c(Common::String("data/other.smk"));
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT_EQUALS(a.toString(), "data/intro.smk");
+		TS_ASSERT_EQUALS(b.c_str(), a.c_str());
+		TS_ASSERT_EQUALS(a.hash(), Common::hashit_lower("data/intro.smk"));
+	}
+
+	void test_empty() {
+		const Common::InternedString empty;
+		TS_ASSERT(empty.empty());
+		TS_ASSERT(empty == Common::InternedString(""));
+		TS_ASSERT(!Common::InternedString("x").empty());
+	}
+
+	void test_lookup() {
+		const uint size = Common::InternedString::getTableSize();
+		TS_ASSERT(Common::InternedString::lookup("never-interned-name").empty());
+		TS_ASSERT_EQUALS(Common::InternedString::getTableSize(), size);
+
+		const Common::InternedString a("lookup-test");
+		TS_ASSERT(Common::InternedString::lookup("LOOKUP-TEST") == a);
+		TS_ASSERT_EQUALS(Common::InternedString::getTableSize(), size + 1);
+	}
+
+	void test_hashmap() {
+		Common::HashMap<Common::InternedString, int> map;
+		map[Common::InternedString("Foo")] = 1;
+		map[Common::InternedString("bar")] = 2;
+		map[Common::InternedString("FOO")] = 3;
+
+		TS_ASSERT_EQUALS(map.size(), 2u);
+		TS_ASSERT_EQUALS(map[Common::InternedString("foo")], 3);
+		TS_ASSERT(map.contains(Common::InternedString("BAR")));
+		TS_ASSERT(!map.contains(Common::InternedString("baz")));
+	}
+};
@@ -0,0 +1,158 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/bufferedstream.h"
+#include "common/substream.h"
+
+class ReadAheadStreamTestSuite : public CxxTest::TestSuite {
+	/** Stream which cannot lend its data and counts the reads made. */
+	class CountingStream : public Common::SeekableReadStream {
+	public:
+		CountingStream(const byte *data, uint32 size) : _stream(data, size), _reads(0), _bytesRead(0) {}
+
+		virtual bool eos() const { return _stream.eos(); }
+		virtual uint32 read(void *dataPtr, uint32 dataSize) {
+			_reads++;
+			uint32 n = _stream.read(dataPtr, dataSize);
+			_bytesRead += n;
+			return n;
+		}
+		virtual int32 pos() const { return _stream.pos(); }
+		virtual int32 size() const { return _stream.size(); }
+		virtual bool seek(int32 offset, int whence = SEEK_SET) { return _stream.seek(offset, whence); }
+
+		Common::MemoryReadStream _stream;
+		uint _reads;
+		uint32 _bytesRead;
+	};
+
+	enum {
+		kDataSize = 256 * 1024
+	};
+
+	byte *makeData() {
+		byte *data = new byte[kDataSize];
+		for (uint32 i = 0; i < kDataSize; ++i)
+			data[i] = (byte)(i ^ (i >> 8));
+		return data;
+	}
+
+	public:
+	void test_sequential() {
+		byte *data = makeData();
+		CountingStream parent(data, kDataSize);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 64 * 1024, DisposeAfterUse::NO);
+
+		bool same = true;
+		for (uint32 i = 0; i < kDataSize; ++i) {
+			TS_ASSERT_EQUALS(stream->pos(), (int32)i);
+			same &= (stream->readByte() == data[i]);
+		}
+		TS_ASSERT(same);
+		TS_ASSERT(!stream->eos());
+
+		// The reads grow to the maximum size: 4+8+16+32 KB, then 64 KB reads
+		TS_ASSERT_EQUALS(parent._reads, 8U);
+
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+
+		delete stream;
+		delete[] data;
+	}
+
+	void test_seek() {
+		byte *data = makeData();
+		CountingStream parent(data, kDataSize);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 64 * 1024, DisposeAfterUse::NO);
+
+		stream->seek(1000);
+		TS_ASSERT_EQUALS(stream->readByte(), data[1000]);
+		TS_ASSERT_EQUALS(parent._reads, 1U);
+
+		// Seeking around in the data already read does not touch the parent
+		stream->seek(500, SEEK_CUR);
+		TS_ASSERT_EQUALS(stream->pos(), 1501);
+		TS_ASSERT_EQUALS(stream->readByte(), data[1501]);
+		stream->seek(3000, SEEK_SET);
+		TS_ASSERT_EQUALS(stream->readByte(), data[3000]);
+		stream->seek(1000, SEEK_SET);
+		TS_ASSERT_EQUALS(stream->readByte(), data[1000]);
+		stream->seek(3000, SEEK_SET);
+		TS_ASSERT_EQUALS(stream->readByte(), data[3000]);
+		TS_ASSERT_EQUALS(parent._reads, 1U);
+
+		// Random seeks only ever read small chunks
+		for (uint32 i = 0; i < 16; ++i) {
+			uint32 offset = (i * 40503) % kDataSize;
+			stream->seek(offset);
+			TS_ASSERT_EQUALS(stream->readByte(), data[offset]);
+		}
+		TS_ASSERT(parent._bytesRead <= 17 * 4096);
+
+		stream->seek(-2, SEEK_END);
+		TS_ASSERT_EQUALS(stream->readUint16BE(), READ_BE_UINT16(data + kDataSize - 2));
+		TS_ASSERT(!stream->eos());
+
+		delete stream;
+		delete[] data;
+	}
+
+	void test_large_read() {
+		byte *data = makeData();
+		CountingStream parent(data, kDataSize);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 64 * 1024, DisposeAfterUse::NO);
+
+		byte *buf = new byte[kDataSize];
+		stream->readByte();
+		TS_ASSERT_EQUALS(stream->read(buf, kDataSize), (uint32)kDataSize - 1);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT(!memcmp(buf, data + 1, kDataSize - 1));
+
+		delete[] buf;
+		delete stream;
+		delete[] data;
+	}
+
+	void test_borrow_data() {
+		byte *data = makeData();
+		CountingStream parent(data, kDataSize);
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(&parent, 64 * 1024, DisposeAfterUse::NO);
+		TS_ASSERT(!stream->hasDataInMemory());
+
+		// Nothing has been read ahead yet
+		TS_ASSERT(!stream->borrowData(16));
+
+		stream->readByte();
+		const byte *borrowed = stream->borrowData(100);
+		TS_ASSERT(borrowed);
+		TS_ASSERT(!memcmp(borrowed, data + 1, 100));
+		TS_ASSERT_EQUALS(stream->pos(), 101);
+
+		// Data past the read-ahead buffer cannot be lent out
+		TS_ASSERT(!stream->borrowData(4096));
+		TS_ASSERT_EQUALS(stream->pos(), 101);
+		TS_ASSERT_EQUALS(parent._reads, 1U);
+
+		delete stream;
+		delete[] data;
+	}
+
+	void test_memory_stream() {
+		byte data[4] = { 1, 2, 3, 4 };
+		Common::SeekableReadStream *ms = new Common::MemoryReadStream(data, sizeof(data));
+
+		// Memory streams are not wrapped when the wrapper would own them
+		Common::SeekableReadStream *stream = Common::wrapReadAheadSeekableReadStream(ms, 4096, DisposeAfterUse::YES);
+		TS_ASSERT_EQUALS(stream, ms);
+		delete stream;
+
+		// Neither are sub streams of them
+		ms = new Common::MemoryReadStream(data, sizeof(data));
+		Common::SeekableReadStream *sub = new Common::SeekableSubReadStream(ms, 1, 3, DisposeAfterUse::YES);
+		TS_ASSERT(sub->hasDataInMemory());
+		stream = Common::wrapReadAheadSeekableReadStream(sub, 4096, DisposeAfterUse::YES);
+		TS_ASSERT_EQUALS(stream, sub);
+		delete stream;
+	}
+};
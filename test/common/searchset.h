@@ -0,0 +1,170 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/interned-str.h"
+#include "common/memstream.h"
+#include "common/str-array.h"
+
+/**
+ * Archive containing a fixed list of names, counting how often it is probed.
+ */
+class CountingArchive : public Common::Archive {
+public:
+	Common::StringArray _names;
+	mutable int _probes;
+
+	CountingArchive(const char *name1, const char *name2 = 0) : _probes(0) {
+		_names.push_back(name1);
+		if (name2)
+			_names.push_back(name2);
+	}
+
+	virtual bool hasFile(const Common::String &name) const {
+		_probes++;
+		for (uint i = 0; i < _names.size(); ++i) {
+			if (_names[i] == name)
+				return true;
+		}
+		return false;
+	}
+
+	virtual int listMembers(Common::ArchiveMemberList &list) const {
+		for (uint i = 0; i < _names.size(); ++i)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_names[i], this)));
+		return _names.size();
+	}
+
+	virtual const Common::ArchiveMemberPtr getMember(const Common::String &name) const {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(name, this));
+	}
+
+	virtual Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const {
+		if (!hasFile(name))
+			return 0;
+		return new Common::MemoryReadStream((const byte *)"x", 1);
+	}
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_lookup_cache() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("a.dat");
+		CountingArchive *b = new CountingArchive("b.dat");
+		set.add("a", a, 1);
+		set.add("b", b, 0);
+
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(a->_probes, 2);
+		TS_ASSERT_EQUALS(b->_probes, 2);
+
+		// Both positive and negative results are cached
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(a->_probes, 2);
+		TS_ASSERT_EQUALS(b->_probes, 2);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("b.dat");
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT_EQUALS(a->_probes, 2);
+		TS_ASSERT_EQUALS(b->_probes, 3);
+		TS_ASSERT(!set.createReadStreamForMember("c.dat"));
+
+		// Adding an archive invalidates the cache
+		set.add("c", new CountingArchive("c.dat", "b.dat"), 2);
+		TS_ASSERT(set.hasFile("c.dat"));
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT_EQUALS(a->_probes, 2);
+
+		set.remove("c");
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT_EQUALS(a->_probes, 3);
+	}
+
+	void test_lookup_cache_nested() {
+		Common::SearchSet set;
+		Common::SearchSet *nested = new Common::SearchSet();
+		set.add("nested", nested);
+
+		TS_ASSERT(!set.hasFile("a.dat"));
+
+		// Changing the nested set invalidates the cache of its parent
+		nested->add("a", new CountingArchive("a.dat"));
+		TS_ASSERT(set.hasFile("a.dat"));
+
+		// Also when an archive is removed from a set nested deeper
+		Common::SearchSet *inner = new Common::SearchSet();
+		inner->add("b", new CountingArchive("b.dat"));
+		nested->add("inner", inner);
+		TS_ASSERT(set.hasFile("b.dat"));
+		inner->remove("b");
+		TS_ASSERT(!set.hasFile("b.dat"));
+		inner->add("b", new CountingArchive("b.dat"));
+		TS_ASSERT(set.hasFile("b.dat"));
+		nested->remove("inner");
+		TS_ASSERT(!set.hasFile("b.dat"));
+	}
+
+	void test_lookup_cache_unrelated() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("a.dat");
+		set.add("a", a);
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT_EQUALS(a->_probes, 1);
+
+		// Other sets changing leave the cache alone
+		Common::SearchSet other;
+		other.add("b", new CountingArchive("b.dat"));
+		other.clear();
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT_EQUALS(a->_probes, 1);
+	}
+
+	void test_lookup_cache_bounded() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("a.dat");
+		set.add("a", a);
+		TS_ASSERT(set.hasFile("a.dat"));
+
+		// Looking up many names flushes the cache rather than growing it
+		for (int i = 0; i < 5000; ++i)
+			TS_ASSERT(!set.hasFile(Common::String::format("%d.dat", i)));
+		TS_ASSERT_EQUALS(a->_probes, 5001);
+		TS_ASSERT(set.hasFile("a.dat"));
+		TS_ASSERT_EQUALS(a->_probes, 5002);
+	}
+
+	void test_lookup_cache_interned() {
+		Common::SearchSet set;
+		CountingArchive *a = new CountingArchive("a.dat");
+		CountingArchive *b = new CountingArchive("b.dat");
+		set.add("a", a, 1);
+		set.add("b", b, 0);
+
+		const Common::InternedString bName("b.dat");
+		const Common::InternedString cName("c.dat");
+		TS_ASSERT(set.hasFile(bName));
+		TS_ASSERT(!set.hasFile(cName));
+		TS_ASSERT_EQUALS(a->_probes, 2);
+		TS_ASSERT_EQUALS(b->_probes, 2);
+
+		// Interned names are cached separately from String ones
+		TS_ASSERT(set.hasFile(bName));
+		TS_ASSERT(!set.hasFile(cName));
+		TS_ASSERT_EQUALS(a->_probes, 2);
+		TS_ASSERT_EQUALS(b->_probes, 2);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember(bName);
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT_EQUALS(a->_probes, 2);
+		TS_ASSERT_EQUALS(b->_probes, 3);
+
+		// Adding an archive invalidates the interned cache as well
+		set.add("c", new CountingArchive("c.dat"), 2);
+		TS_ASSERT(set.hasFile(cName));
+		TS_ASSERT(!set.hasFile(Common::InternedString()));
+	}
+};
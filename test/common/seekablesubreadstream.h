@@ -70,4 +70,22 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+
+	void test_borrow_data() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::SafeSeekableSubReadStream ssrs(&ms, 2, 8);
+
+		// The parent position does not matter to a safe substream
+		ms.seek(9);
+		const byte *data = ssrs.borrowData(4);
+		TS_ASSERT_EQUALS(data, contents + 2);
+		TS_ASSERT_EQUALS(ssrs.pos(), 4);
+
+		// Borrowing past the end of the substream fails
+		TS_ASSERT(!ssrs.borrowData(3));
+		TS_ASSERT_EQUALS(ssrs.pos(), 4);
+		TS_ASSERT_EQUALS(ssrs.readByte(), 6);
+	}
 };
@@ -2,6 +2,7 @@
 
 class SpanTestSuite;
 
+#include "common/bufferedstream.h"
 #include "common/span.h"
 #include "common/str.h"
 
@@ -805,4 +806,37 @@ public:
 			}
 		}
 	}
+
+	void test_stream_span() {
+		byte data[] = { 'h', 'e', 'l', 'l', 'o' };
+
+		{
+			Common::MemoryReadStream stream(data, sizeof(data));
+			stream.seek(1);
+			Common::StreamSpan span(stream, 3);
+			TS_ASSERT(span.isBorrowed());
+			TS_ASSERT_EQUALS(span->data(), data + 1);
+			TS_ASSERT_EQUALS(span->size(), 3U);
+			TS_ASSERT_EQUALS(stream.pos(), 4);
+		}
+
+		{
+			Common::SeekableReadStream *stream = Common::wrapBufferedSeekableReadStream(new Common::MemoryReadStream(data, sizeof(data)), 2, DisposeAfterUse::YES);
+			stream->seek(1);
+			{
+				Common::StreamSpan span(*stream, 3);
+				TS_ASSERT(!span.isBorrowed());
+				TS_ASSERT_EQUALS(span->size(), 3U);
+				TS_ASSERT_EQUALS((*span)[0], 'e');
+				TS_ASSERT_EQUALS((*span)[2], 'l');
+				TS_ASSERT_EQUALS(stream->pos(), 4);
+			}
+
+			// Only the bytes actually read are covered
+			Common::StreamSpan span(*stream, 3);
+			TS_ASSERT_EQUALS(span->size(), 1U);
+			TS_ASSERT_EQUALS((*span)[0], 'o');
+			delete stream;
+		}
+	}
 };
@@ -260,6 +260,25 @@ class StringTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(str2, "01234567890123456789012345678901");
 	}
 
+	void test_swap() {
+		Common::String shortStr("Hello");
+		Common::String longStr("01234567890123456789012345678901");
+		Common::String shared(longStr);
+
+		// Mixing internal and external storage
+		SWAP(shortStr, longStr);
+		TS_ASSERT_EQUALS(shortStr, "01234567890123456789012345678901");
+		TS_ASSERT_EQUALS(longStr, "Hello");
+		longStr += " world";
+		TS_ASSERT_EQUALS(longStr, "Hello world");
+
+		// The storage stays shared, so changing one copy still unshares it
+		SWAP(shortStr, shared);
+		shortStr.deleteLastChar();
+		TS_ASSERT_EQUALS(shortStr, "0123456789012345678901234567890");
+		TS_ASSERT_EQUALS(shared, "01234567890123456789012345678901");
+	}
+
 	void test_lastPathComponent() {
 		TS_ASSERT_EQUALS(Common::lastPathComponent("/", '/'), "");
 		TS_ASSERT_EQUALS(Common::lastPathComponent("/foo/bar", '/'), "bar");
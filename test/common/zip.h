@@ -0,0 +1,68 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/unzip.h"
+
+class ZipTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_truncated_central_directory() {
+		// A stored file "a.txt", whose central directory entry claims an
+		// extra field reaching past the end of the central directory,
+		// which in turn claims to hold a second entry.
+		Common::MemoryWriteStreamDynamic zip(DisposeAfterUse::NO);
+
+		zip.writeUint32LE(0x04034b50);	// local file header
+		zip.writeUint16LE(10);			// version needed
+		zip.writeUint16LE(0);			// flags
+		zip.writeUint16LE(0);			// stored
+		zip.writeUint32LE(0);			// time and date
+		zip.writeUint32LE(0x3610a686);	// crc of "hello"
+		zip.writeUint32LE(5);			// compressed size
+		zip.writeUint32LE(5);			// uncompressed size
+		zip.writeUint16LE(5);			// name length
+		zip.writeUint16LE(0);			// extra field length
+		zip.write("a.txt", 5);
+		zip.write("hello", 5);
+
+		const uint32 centralDirOffset = zip.pos();
+		zip.writeUint32LE(0x02014b50);	// central directory entry
+		zip.writeUint16LE(20);			// version made by
+		zip.writeUint16LE(10);			// version needed
+		zip.writeUint16LE(0);			// flags
+		zip.writeUint16LE(0);			// stored
+		zip.writeUint32LE(0);			// time and date
+		zip.writeUint32LE(0x3610a686);	// crc
+		zip.writeUint32LE(5);			// compressed size
+		zip.writeUint32LE(5);			// uncompressed size
+		zip.writeUint16LE(5);			// name length
+		zip.writeUint16LE(0x800);		// extra field length
+		zip.writeUint16LE(0);			// comment length
+		zip.writeUint16LE(0);			// disk number
+		zip.writeUint16LE(0);			// internal attributes
+		zip.writeUint32LE(0);			// external attributes
+		zip.writeUint32LE(0);			// local header offset
+		zip.write("a.txt", 5);
+		const uint32 centralDirSize = zip.pos() - centralDirOffset;
+
+		zip.writeUint32LE(0x06054b50);	// end of central directory
+		zip.writeUint16LE(0);			// disk number
+		zip.writeUint16LE(0);			// disk with the central directory
+		zip.writeUint16LE(2);			// entries on this disk
+		zip.writeUint16LE(2);			// entries
+		zip.writeUint32LE(centralDirSize);
+		zip.writeUint32LE(centralDirOffset);
+		zip.writeUint16LE(0);			// comment length
+
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(zip.getData(), zip.size(), DisposeAfterUse::YES));
+		TS_ASSERT(archive != 0);
+		if (archive) {
+			TS_ASSERT(archive->hasFile("a.txt"));
+
+			Common::ArchiveMemberList members;
+			TS_ASSERT_EQUALS(archive->listMembers(members), 1);
+			delete archive;
+		}
+	}
+};
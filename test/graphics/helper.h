@@ -0,0 +1,18 @@
+#ifndef TEST_GRAPHICS_HELPER_H
+#define TEST_GRAPHICS_HELPER_H
+
+#include "graphics/surface.h"
+
+#include "../common/helper.h"
+
+/**
+ * Fill all bytes of a surface, including the padding of each row, with
+ * pseudo random data.
+ */
+static inline void fillRandom(Graphics::Surface &surf, TestRandom &rnd) {
+	byte *p = (byte *)surf.getPixels();
+	for (int i = 0; i < surf.pitch * surf.h; ++i)
+		p[i] = rnd.next() >> 16;
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+
+#include "helper.h"
+
+/**
+ * Check the blits of ManagedSurface against a pixel by pixel reference.
+ */
+class ManagedSurfaceTestSuite : public CxxTest::TestSuite {
+	TestRandom _random;
+
+	void fillSurface(Graphics::Surface &surf) {
+		fillRandom(surf, _random);
+
+		// Use a few values often, so that the transparent color shows up
+		for (int y = 0; y < surf.h; ++y) {
+			for (int x = 0; x < surf.w; ++x) {
+				const uint32 color = getPixel(surf, x, y);
+				if (color & 1)
+					setPixel(surf, x, y, color & 3);
+			}
+		}
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surf, int x, int y) {
+		const void *p = surf.getBasePtr(x, y);
+		if (surf.format.bytesPerPixel == 1)
+			return *(const byte *)p;
+		else if (surf.format.bytesPerPixel == 2)
+			return *(const uint16 *)p;
+		return *(const uint32 *)p;
+	}
+
+	static void setPixel(Graphics::Surface &surf, int x, int y, uint32 color) {
+		void *p = surf.getBasePtr(x, y);
+		if (surf.format.bytesPerPixel == 1)
+			*(byte *)p = color;
+		else if (surf.format.bytesPerPixel == 2)
+			*(uint16 *)p = color;
+		else
+			*(uint32 *)p = color;
+	}
+
+	static uint32 blend(uint32 srcVal, uint32 destVal, const Graphics::PixelFormat &srcFormat, const Graphics::PixelFormat &destFormat) {
+		byte a, r, g, b, dr, dg, db;
+		srcFormat.colorToARGB(srcVal, a, r, g, b);
+		destFormat.colorToRGB(destVal, dr, dg, db);
+		if (a == 0)
+			return destVal;
+		if (a != 0xff) {
+			const double alpha = a / 255.0;
+			r = static_cast<byte>(r * alpha + dr * (1.0 - alpha));
+			g = static_cast<byte>(g * alpha + dg * (1.0 - alpha));
+			b = static_cast<byte>(b * alpha + db * (1.0 - alpha));
+		}
+		return destFormat.ARGBToColor(0xff, r, g, b);
+	}
+
+	void checkTransBlit(const Graphics::PixelFormat &srcFormat, const Graphics::PixelFormat &destFormat,
+			const Common::Rect &srcRect, const Common::Rect &destRect, bool flipped, uint overrideColor) {
+		Graphics::Surface src, expected;
+		src.create(24, 16, srcFormat);
+		expected.create(32, 20, destFormat);
+		fillSurface(src);
+		fillSurface(expected);
+		Graphics::ManagedSurface dest(32, 20, destFormat);
+		dest.blitFrom(expected);
+
+		const uint transColor = 2;
+		const bool sameFormat = srcFormat == destFormat;
+		for (int y = MAX<int>(destRect.top, 0); y < MIN<int>(destRect.bottom, expected.h); ++y) {
+			const int sy = srcRect.top + (y - destRect.top) * (256 * srcRect.height() / destRect.height()) / 256;
+			for (int x = MAX<int>(destRect.left, 0); x < MIN<int>(destRect.right, expected.w); ++x) {
+				int sx = (x - destRect.left) * (256 * srcRect.width() / destRect.width()) / 256;
+				if (flipped)
+					sx = src.w - sx - 1;
+				const uint32 srcVal = getPixel(src, srcRect.left + sx, sy);
+				if (srcVal == transColor)
+					continue;
+				if (sameFormat)
+					setPixel(expected, x, y, overrideColor ? overrideColor : srcVal);
+				else
+					setPixel(expected, x, y, blend(srcVal, getPixel(expected, x, y), srcFormat, destFormat));
+			}
+		}
+
+		dest.transBlitFrom(src, srcRect, destRect, transColor, flipped, overrideColor);
+		TS_ASSERT_EQUALS(memcmp(dest.getPixels(), expected.getPixels(), dest.pitch * dest.h), 0);
+
+		src.free();
+		expected.free();
+	}
+
+	public:
+	void setUp() {
+		_random.setSeed(1);
+	}
+
+	void test_trans_blit() {
+		const Graphics::PixelFormat clut8 = Graphics::PixelFormat::createFormatCLUT8();
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb4444(2, 4, 4, 4, 4, 8, 4, 0, 12);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+
+		const Common::Rect srcRects[] = { Common::Rect(0, 0, 24, 16), Common::Rect(0, 2, 10, 9) };
+		const Common::Rect destRects[] = {
+			Common::Rect(4, 2, 28, 18), Common::Rect(-5, -3, 19, 13), Common::Rect(20, 10, 60, 30), Common::Rect(1, 1, 8, 6)
+		};
+
+		for (int s = 0; s < ARRAYSIZE(srcRects); ++s) {
+			for (int d = 0; d < ARRAYSIZE(destRects); ++d) {
+				for (int flipped = 0; flipped < 2; ++flipped) {
+					// Flipping works relative to the whole source surface
+					if (flipped && s != 0)
+						continue;
+					checkTransBlit(clut8, clut8, srcRects[s], destRects[d], flipped, 0);
+					checkTransBlit(clut8, clut8, srcRects[s], destRects[d], flipped, 7);
+					checkTransBlit(rgb565, rgb565, srcRects[s], destRects[d], flipped, 0);
+					checkTransBlit(argb8888, argb8888, srcRects[s], destRects[d], flipped, 0);
+					checkTransBlit(argb4444, rgb565, srcRects[s], destRects[d], flipped, 0);
+					checkTransBlit(argb8888, rgb565, srcRects[s], destRects[d], flipped, 0);
+					checkTransBlit(argb4444, argb8888, srcRects[s], destRects[d], flipped, 0);
+				}
+			}
+		}
+	}
+
+	void test_blit_convert() {
+		const Graphics::PixelFormat argb4444(2, 4, 4, 4, 4, 8, 4, 0, 12);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+
+		Graphics::Surface src, expected;
+		src.create(20, 12, argb8888);
+		expected.create(16, 16, argb4444);
+		fillSurface(src);
+		fillSurface(expected);
+		Graphics::ManagedSurface dest(16, 16, argb4444);
+		dest.blitFrom(expected);
+
+		for (int y = 0; y < 7; ++y) {
+			for (int x = 0; x < 10; ++x) {
+				const uint32 destVal = getPixel(expected, x + 6, y + 9);
+				setPixel(expected, x + 6, y + 9, blend(getPixel(src, x + 2, y + 1), destVal, argb8888, argb4444));
+			}
+		}
+
+		dest.blitFrom(src, Common::Rect(2, 1, 18, 11), Common::Point(6, 9));
+		TS_ASSERT_EQUALS(memcmp(dest.getPixels(), expected.getPixels(), dest.pitch * dest.h), 0);
+
+		src.free();
+		expected.free();
+	}
+};
@@ -0,0 +1,122 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scaler.h"
+
+#include "helper.h"
+
+#if defined(USE_SCALERS) && defined(USE_HQ_SCALERS) && !defined(USE_NASM)
+
+#include "graphics/scaler/intern.h"
+
+extern "C" uint32 *RGBtoYUV;
+
+/**
+ * Check HQ2x and HQ3x against the output of the original C implementation,
+ * and the patterns computed with vector instructions against diffYUV().
+ */
+class HqxTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 67,
+		kHeight = 23,
+		kSrcWidth = kWidth + 2,
+		kSrcHeight = kHeight + 2
+	};
+
+	uint16 _src[kSrcWidth * kSrcHeight];
+	uint16 _dst[kWidth * 3 * kHeight * 3];
+
+	const uint16 *pixel(int x, int y) const {
+		return _src + (y + 1) * kSrcWidth + x + 1;
+	}
+
+	uint32 scale(ScalerProc *scaler, int factor) {
+		memset(_dst, 0, sizeof(_dst));
+		scaler((const uint8 *)pixel(0, 0), kSrcWidth * 2, (uint8 *)_dst, kWidth * factor * 2, kWidth, kHeight);
+
+		// FNV-1a hash of the output
+		uint32 hash = 2166136261u;
+		for (int i = 0; i < kWidth * factor * kHeight * factor; ++i) {
+			hash = (hash ^ (_dst[i] & 0xFF)) * 16777619u;
+			hash = (hash ^ (_dst[i] >> 8)) * 16777619u;
+		}
+		return hash;
+	}
+
+public:
+	void setUp() {
+		// Stripes, noise and slightly different shades, which give most of
+		// the 256 patterns
+		TestRandom rnd;
+		for (int i = 0; i < kSrcWidth * kSrcHeight; ++i) {
+			const uint32 seed = rnd.next();
+			const int x = i % kSrcWidth, y = i / kSrcWidth;
+			uint16 color = ((x / 4 + y / 3) & 1) ? 0x7BEF : 0x2104;
+			if ((seed >> 24) < 96)
+				color = (uint16)(seed >> 8);
+			else if ((seed >> 24) < 128)
+				color += 0x0821;
+			_src[i] = color;
+		}
+	}
+
+	void tearDown() {
+		DestroyScalers();
+	}
+
+	void test_hq_565() {
+		InitScalers(565);
+		TS_ASSERT_EQUALS(scale(HQ2x, 2), 0xC2AAB828u);
+		TS_ASSERT_EQUALS(scale(HQ3x, 3), 0x7F62D491u);
+	}
+
+	void test_hq_555() {
+		InitScalers(555);
+		TS_ASSERT_EQUALS(scale(HQ2x, 2), 0x2AC0D999u);
+		TS_ASSERT_EQUALS(scale(HQ3x, 3), 0x5042C6A6u);
+	}
+
+#ifdef HQX_VECTOR_PATTERNS
+	void test_patterns() {
+		InitScalers(565);
+
+		// Neighbour offsets of w1 to w9, the bits they set, and the pairs
+		// of neighbours compared for the extra flags
+		static const int dx[] = { -1, 0, 1, -1, 0, 1, -1, 0, 1 };
+		static const int dy[] = { -1, -1, -1, 0, 0, 0, 1, 1, 1 };
+		static const struct { int a, b, flag; } pairs[] = {
+			{ 4, 2, kHqxDiff42 }, { 2, 6, kHqxDiff26 }, { 8, 4, kHqxDiff84 }, { 6, 8, kHqxDiff68 }
+		};
+
+		for (int width = 1; width <= kHqxMaxPatterns && width <= kWidth; ++width) {
+			for (int y = 0; y < kHeight; ++y) {
+				uint16 patterns[kHqxMaxPatterns];
+				const int left = (y * 7) % (kWidth - width + 1);
+				hqxPatterns(pixel(left, y), kSrcWidth, width, patterns);
+
+				for (int x = 0; x < width; ++x) {
+					uint32 yuv[10];
+					for (int n = 1; n <= 9; ++n)
+						yuv[n] = RGBtoYUV[*pixel(left + x + dx[n - 1], y + dy[n - 1])];
+
+					int expected = 0, bit = 1;
+					for (int n = 1; n <= 9; ++n) {
+						if (n == 5)
+							continue;
+						if (diffYUV(yuv[5], yuv[n]))
+							expected |= bit;
+						bit <<= 1;
+					}
+					for (uint i = 0; i < ARRAYSIZE(pairs); ++i) {
+						if (diffYUV(yuv[pairs[i].a], yuv[pairs[i].b]))
+							expected |= pairs[i].flag;
+					}
+
+					TS_ASSERT_EQUALS(patterns[x], expected);
+				}
+			}
+		}
+	}
+#endif
+};
+
+#endif
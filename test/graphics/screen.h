@@ -0,0 +1,194 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/screen.h"
+
+#include "helper.h"
+
+/**
+ * Check that the dirty tile grid used by Graphics::Screen turns the marked
+ * areas into rects that cover all of them without overlapping.
+ */
+class DirtyTileGridTestSuite : public CxxTest::TestSuite {
+	enum { kWidth = 320, kHeight = 200 };
+
+	byte _marked[kHeight][kWidth];
+	byte _covered[kHeight][kWidth];
+
+	void mark(Graphics::DirtyTileGrid &grid, const Common::Rect &r) {
+		grid.addRect(r);
+		Common::Rect area = r;
+		area.clip(Common::Rect(kWidth, kHeight));
+		for (int y = area.top; y < area.bottom; ++y)
+			for (int x = area.left; x < area.right; ++x)
+				_marked[y][x] = 1;
+	}
+
+	void checkCoverage(const Common::Array<Common::Rect> &rects) {
+		memset(_covered, 0, sizeof(_covered));
+		for (uint i = 0; i < rects.size(); ++i) {
+			const Common::Rect &r = rects[i];
+			TS_ASSERT(!r.isEmpty());
+			TS_ASSERT(Common::Rect(kWidth, kHeight).contains(r));
+			for (int y = r.top; y < r.bottom; ++y)
+				for (int x = r.left; x < r.right; ++x)
+					++_covered[y][x];
+		}
+
+		for (int y = 0; y < kHeight; ++y) {
+			for (int x = 0; x < kWidth; ++x) {
+				TS_ASSERT(_covered[y][x] <= 1);
+				if (_marked[y][x])
+					TS_ASSERT_EQUALS(_covered[y][x], 1);
+			}
+		}
+	}
+
+public:
+	void setUp() {
+		memset(_marked, 0, sizeof(_marked));
+	}
+
+	void test_empty() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+		TS_ASSERT(grid.empty());
+
+		Common::Array<Common::Rect> rects;
+		grid.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 0u);
+
+		mark(grid, Common::Rect(-20, -20, -1, -1));
+		TS_ASSERT(grid.empty());
+	}
+
+	void test_single_rect_is_exact() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+		mark(grid, Common::Rect(3, 5, 40, 37));
+
+		Common::Array<Common::Rect> rects;
+		grid.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(3, 5, 40, 37));
+	}
+
+	void test_few_rects_are_exact() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+		TestRandom rnd;
+		uint marked = 0;
+		for (int i = 0; i < 40; ++i) {
+			int x = (rnd.next() >> 8) % kWidth;
+			const uint32 seed = rnd.next();
+			int y = (seed >> 8) % kHeight;
+			mark(grid, Common::Rect(x, y, x + 1 + (seed >> 4) % 24, y + 1 + (seed >> 12) % 24));
+		}
+		for (int y = 0; y < kHeight; ++y)
+			for (int x = 0; x < kWidth; ++x)
+				marked += _marked[y][x];
+
+		Common::Array<Common::Rect> rects;
+		TS_ASSERT_EQUALS(grid.getRects(rects), 0u);
+		checkCoverage(rects);
+
+		// Merging overlapping sprites copies a little more than was marked,
+		// but nowhere near the tiles they touch
+		uint copied = 0;
+		for (uint i = 0; i < rects.size(); ++i)
+			copied += rects[i].width() * rects[i].height();
+		TS_ASSERT_LESS_THAN(copied, marked * 2);
+	}
+
+	void test_chained_overlaps() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+
+		// The last rect joins the first two, and the result then overlaps
+		// the third
+		mark(grid, Common::Rect(0, 0, 10, 10));
+		mark(grid, Common::Rect(30, 0, 40, 10));
+		mark(grid, Common::Rect(15, 20, 25, 30));
+		mark(grid, Common::Rect(5, 5, 35, 25));
+
+		Common::Array<Common::Rect> rects;
+		grid.getRects(rects);
+		checkCoverage(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(0, 0, 40, 30));
+	}
+
+	void test_tiles_trimmed_separately() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+		mark(grid, Common::Rect(2, 3, 5, 6));
+		mark(grid, Common::Rect(4, 5, 9, 9));
+		mark(grid, Common::Rect(300, 12, 304, 15));
+		mark(grid, Common::Rect(2, 100, 5, 103));
+
+		// Too many areas to return directly, so the tiles are used. Each
+		// rect is trimmed to what was marked in its own tiles.
+		Common::Array<Common::Rect> rects;
+		TS_ASSERT_DIFFERS(grid.getRects(rects, 3), 0u);
+		checkCoverage(rects);
+		TS_ASSERT_EQUALS(rects.size(), 3u);
+		for (uint i = 0; i < rects.size(); ++i) {
+			TS_ASSERT(rects[i] == Common::Rect(2, 3, 9, 9) ||
+				rects[i] == Common::Rect(300, 12, 304, 15) ||
+				rects[i] == Common::Rect(2, 100, 5, 103));
+		}
+	}
+
+	void test_overlapping_rects() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+		mark(grid, Common::Rect(0, 0, 64, 64));
+		mark(grid, Common::Rect(32, 32, 100, 80));
+		mark(grid, Common::Rect(200, 150, 330, 210));
+
+		Common::Array<Common::Rect> rects;
+		grid.getRects(rects);
+		checkCoverage(rects);
+		TS_ASSERT_LESS_THAN_EQUALS(rects.size(), 4u);
+	}
+
+	void test_many_sprites() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+		TestRandom rnd;
+		for (int i = 0; i < 500; ++i) {
+			int x = (rnd.next() >> 8) % kWidth;
+			const uint32 seed = rnd.next();
+			int y = (seed >> 8) % kHeight;
+			mark(grid, Common::Rect(x, y, x + 1 + (seed >> 4) % 24, y + 1 + (seed >> 12) % 24));
+		}
+
+		Common::Array<Common::Rect> rects;
+		grid.getRects(rects);
+		checkCoverage(rects);
+		TS_ASSERT_LESS_THAN_EQUALS(rects.size(), (uint)Graphics::DirtyTileGrid::kMaxRects);
+
+		// A small limit forces whole rows, then the bounding box
+		grid.getRects(rects, 16);
+		checkCoverage(rects);
+		TS_ASSERT_LESS_THAN_EQUALS(rects.size(), 16u);
+
+		grid.getRects(rects, 1);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], grid.getBounds());
+	}
+
+	void test_clear() {
+		Graphics::DirtyTileGrid grid;
+		grid.resize(kWidth, kHeight);
+		mark(grid, Common::Rect(100, 100, 120, 120));
+		grid.clear();
+		TS_ASSERT(grid.empty());
+
+		memset(_marked, 0, sizeof(_marked));
+		mark(grid, Common::Rect(10, 10, 12, 12));
+		Common::Array<Common::Rect> rects;
+		grid.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT_EQUALS(rects[0], Common::Rect(10, 10, 12, 12));
+	}
+};
@@ -0,0 +1,200 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+#include "graphics/transparent_surface.h"
+#include "graphics/transform_struct.h"
+
+#include "helper.h"
+
+/**
+ * Check TransparentSurface::blit against a straightforward implementation
+ * of each blend mode, for sprite widths which exercise both the vectorized
+ * loops and the scalar code handling the remaining pixels.
+ */
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite {
+#ifdef SCUMM_LITTLE_ENDIAN
+	enum { kA = 0, kB = 1, kG = 2, kR = 3 };
+#else
+	enum { kA = 3, kB = 2, kG = 1, kR = 0 };
+#endif
+
+	TestRandom _random;
+
+	void fillSprite(Graphics::Surface &surf) {
+		fillRandom(surf, _random);
+
+		// Make sure that fully transparent and opaque pixels are covered
+		for (int y = 0; y < surf.h; ++y) {
+			for (int x = 0; x < surf.w; x += 3)
+				((byte *)surf.getBasePtr(x, y))[kA] = (x & 1) ? 255 : 0;
+		}
+	}
+
+	static byte modulate(byte v, byte c, uint ina, uint shift) {
+		return c != 255 ? (v * c * ina) >> (shift + 8) : (v * ina) >> shift;
+	}
+
+	static void blendPixel(const byte *in, byte *out, Graphics::TSpriteBlendMode mode, uint32 color) {
+		static const int channels[3] = { kB, kG, kR };
+		const byte ca = color >> 24, cr = color >> 16, cg = color >> 8, cb = color;
+		const byte tint[4] = { 0, cb, cg, cr };
+		const uint a = in[kA];
+		const uint ina = a * ca >> 8;
+
+		if (color == 0xffffffff) {
+			if (a == 0)
+				return;
+			for (int i = 0; i < 3; ++i) {
+				const int c = channels[i];
+				if (mode == Graphics::BLEND_ADDITIVE)
+					out[c] = MIN<uint>((in[c] * a >> 8) + out[c], 255);
+				else if (mode == Graphics::BLEND_SUBTRACTIVE)
+					out[c] = out[c] - (in[c] * out[c] * a >> 16);
+				else if (mode == Graphics::BLEND_MULTIPLY)
+					out[c] = (in[c] * a >> 8) * out[c] >> 8;
+				else
+					out[c] = (in[c] * a + out[c] * (255 - a)) >> 8;
+			}
+			if (mode == Graphics::BLEND_NORMAL)
+				out[kA] = 255;
+			return;
+		}
+
+		for (int i = 0; i < 3; ++i) {
+			const int c = channels[i];
+			if (mode == Graphics::BLEND_ADDITIVE)
+				out[c] = MIN<uint>(out[c] + modulate(in[c], tint[i + 1], ina, 8), 255);
+			else if (mode == Graphics::BLEND_SUBTRACTIVE)
+				out[c] = out[c] - (tint[i + 1] != 255 ? (uint)(in[c] * tint[i + 1] * out[c]) * a >> 24 : in[c] * out[c] * a >> 16);
+			else if (mode == Graphics::BLEND_MULTIPLY)
+				out[c] = out[c] * modulate(in[c], tint[i + 1], ina, 8) >> 8;
+			else
+				out[c] = (out[c] * (255 - ina) >> 8) + (in[c] * ina * tint[i + 1] >> 16);
+		}
+		if (mode == Graphics::BLEND_NORMAL || mode == Graphics::BLEND_SUBTRACTIVE)
+			out[kA] = 255;
+	}
+
+	void checkBlend(Graphics::TSpriteBlendMode mode, uint32 color) {
+		for (int w = 1; w <= 13; ++w) {
+			for (int flipping = 0; flipping <= Graphics::FLIP_HV; ++flipping) {
+				Graphics::TransparentSurface src, dst, expected;
+				src.create(w, 3, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+				dst.create(16, 4, src.format);
+				fillSprite(src);
+				fillSprite(dst);
+				expected.copyFrom(dst);
+
+				for (int y = 0; y < src.h; ++y) {
+					for (int x = 0; x < w; ++x) {
+						const int sx = (flipping & Graphics::FLIP_H) ? w - 1 - x : x;
+						const int sy = (flipping & Graphics::FLIP_V) ? src.h - 1 - y : y;
+						blendPixel((const byte *)src.getBasePtr(sx, sy), (byte *)expected.getBasePtr(x + 1, y), mode, color);
+					}
+				}
+
+				src.blit(dst, 1, 0, flipping, 0, color, -1, -1, mode);
+				TS_ASSERT_EQUALS(memcmp(dst.getPixels(), expected.getPixels(), dst.pitch * dst.h), 0);
+
+				src.free();
+				dst.free();
+				expected.free();
+			}
+		}
+	}
+
+	/**
+	 * Blit the transformed copy of src onto one copy of dst, and src itself
+	 * with blitScaled()/blitRotoscaled() onto another, and compare.
+	 */
+	template<Graphics::TFilteringMode filteringMode>
+	void checkTransform(const Graphics::TransformStruct &transform, int newWidth, int newHeight) {
+		static const Common::Rect clips[] = { Common::Rect(0, 0, 48, 40), Common::Rect(7, 3, 30, 37) };
+		static const int positions[][2] = { { 2, 1 }, { -5, -3 }, { 20, 15 } };
+
+		Graphics::TransparentSurface src;
+		src.create(13, 9, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillSprite(src);
+
+		Graphics::TransparentSurface *copy;
+		if (transform._angle != 0)
+			copy = src.rotoscaleT<filteringMode>(transform);
+		else
+			copy = src.scaleT<filteringMode>(newWidth, newHeight);
+
+		for (int c = 0; c < ARRAYSIZE(clips); ++c) {
+			for (int p = 0; p < ARRAYSIZE(positions); ++p) {
+				for (int flipping = 0; flipping <= Graphics::FLIP_HV; ++flipping) {
+					Graphics::TransparentSurface dst, expected;
+					dst.create(48, 40, src.format);
+					fillSprite(dst);
+					expected.copyFrom(dst);
+
+					const uint color = (flipping & 1) ? 0xffffffff : 0xc0ff80a0;
+					const int x = positions[p][0], y = positions[p][1];
+					Common::Rect drawn, expectedDrawn;
+					expectedDrawn = copy->blitClip(expected, clips[c], x, y, flipping, nullptr, color);
+					if (transform._angle != 0)
+						drawn = src.blitRotoscaled<filteringMode>(dst, clips[c], x, y, transform, flipping, color);
+					else
+						drawn = src.blitScaled<filteringMode>(dst, clips[c], x, y, newWidth, newHeight, flipping, color);
+
+					TS_ASSERT_EQUALS(drawn.width(), expectedDrawn.width());
+					TS_ASSERT_EQUALS(drawn.height(), expectedDrawn.height());
+					TS_ASSERT_EQUALS(memcmp(dst.getPixels(), expected.getPixels(), dst.pitch * dst.h), 0);
+
+					dst.free();
+					expected.free();
+				}
+			}
+		}
+
+		copy->free();
+		delete copy;
+		src.free();
+	}
+
+	public:
+	void setUp() {
+		_random.setSeed(1);
+	}
+
+	void test_alpha_blend() {
+		checkBlend(Graphics::BLEND_NORMAL, 0xffffffff);
+		checkBlend(Graphics::BLEND_NORMAL, 0x80ff40c0);
+	}
+
+	void test_additive_blend() {
+		checkBlend(Graphics::BLEND_ADDITIVE, 0xffffffff);
+		checkBlend(Graphics::BLEND_ADDITIVE, 0x80ff40c0);
+		checkBlend(Graphics::BLEND_ADDITIVE, 0xff20ffff);
+	}
+
+	void test_subtractive_blend() {
+		checkBlend(Graphics::BLEND_SUBTRACTIVE, 0xffffffff);
+		checkBlend(Graphics::BLEND_SUBTRACTIVE, 0x80ff40c0);
+		checkBlend(Graphics::BLEND_SUBTRACTIVE, 0xff20ffff);
+	}
+
+	void test_multiply_blend() {
+		checkBlend(Graphics::BLEND_MULTIPLY, 0xffffffff);
+		checkBlend(Graphics::BLEND_MULTIPLY, 0x80ff40c0);
+		checkBlend(Graphics::BLEND_MULTIPLY, 0xff20ffff);
+	}
+
+	void test_blit_scaled() {
+		checkTransform<Graphics::FILTER_NEAREST>(Graphics::TransformStruct(), 29, 17);
+		checkTransform<Graphics::FILTER_NEAREST>(Graphics::TransformStruct(), 6, 5);
+		checkTransform<Graphics::FILTER_BILINEAR>(Graphics::TransformStruct(), 29, 17);
+		checkTransform<Graphics::FILTER_BILINEAR>(Graphics::TransformStruct(), 6, 5);
+	}
+
+	void test_blit_rotoscaled() {
+		const Graphics::TransformStruct rotated(150, 80, 30, 6, 4);
+		const Graphics::TransformStruct upsideDown(100, 100, 180, 0, 0);
+		checkTransform<Graphics::FILTER_NEAREST>(rotated, 0, 0);
+		checkTransform<Graphics::FILTER_NEAREST>(upsideDown, 0, 0);
+		checkTransform<Graphics::FILTER_BILINEAR>(rotated, 0, 0);
+		checkTransform<Graphics::FILTER_BILINEAR>(upsideDown, 0, 0);
+	}
+};
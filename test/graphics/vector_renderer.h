@@ -0,0 +1,87 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/VectorRendererSpec.h"
+
+#include "helper.h"
+
+template<typename PixelType>
+class BlendFillTestRenderer : public Graphics::VectorRendererSpec<PixelType> {
+public:
+	BlendFillTestRenderer(const Graphics::PixelFormat &format) : Graphics::VectorRendererSpec<PixelType>(format) {}
+
+	using Graphics::VectorRendererSpec<PixelType>::blendFill;
+};
+
+/**
+ * Check VectorRendererSpec::blendFill against blending each pixel on its
+ * own, for row lengths which exercise both the vectorized loops and the
+ * scalar code handling the remaining pixels.
+ */
+class VectorRendererTestSuite : public CxxTest::TestSuite {
+	TestRandom _random;
+
+	static uint blendChannel(uint dst, uint src, uint mask, uint shift, uint alpha) {
+		const int d = (dst & mask) >> shift;
+		const int s = (src & mask) >> shift;
+		return (((d + (((s - d) * (int)alpha) >> 8)) << shift) & mask);
+	}
+
+	// The blending of VectorRendererSpec::blendPixelPtr
+	static uint32 blendPixel(const Graphics::PixelFormat &format, uint32 dst, uint32 color, uint alpha) {
+		const uint32 rMask = (0xFFu >> format.rLoss) << format.rShift;
+		const uint32 gMask = (0xFFu >> format.gLoss) << format.gShift;
+		const uint32 bMask = (0xFFu >> format.bLoss) << format.bShift;
+		const uint32 aMask = (0xFFu >> format.aLoss) << format.aShift;
+
+		if (alpha == 0xff)
+			return color | aMask;
+
+		const uint32 opaque = (format.bytesPerPixel == 4) ? (0xFFu << format.aShift) : aMask;
+		return blendChannel(dst, color, rMask, format.rShift, alpha) |
+		       blendChannel(dst, color, gMask, format.gShift, alpha) |
+		       blendChannel(dst, color, bMask, format.bShift, alpha) |
+		       blendChannel(dst, opaque, aMask, format.aShift, alpha);
+	}
+
+	template<typename PixelType>
+	void checkFormat(const Graphics::PixelFormat &format) {
+		enum { kRowSize = 48, kOffset = 3 };
+
+		BlendFillTestRenderer<PixelType> renderer(format);
+		static const uint alphas[] = { 0, 1, 63, 127, 128, 200, 254, 255 };
+
+		for (int width = 0; width <= kRowSize - 2 * kOffset; ++width) {
+			for (uint i = 0; i < ARRAYSIZE(alphas); ++i) {
+				PixelType row[kRowSize], expected[kRowSize];
+				for (int x = 0; x < kRowSize; ++x)
+					row[x] = expected[x] = (PixelType)(_random.next() >> 8);
+
+				const PixelType color = (PixelType)(_random.next() >> 8);
+				for (int x = kOffset; x < kOffset + width; ++x)
+					expected[x] = (PixelType)blendPixel(format, row[x], color, alphas[i]);
+
+				renderer.blendFill(row + kOffset, row + kOffset + width, color, alphas[i]);
+
+				for (int x = 0; x < kRowSize; ++x)
+					TS_ASSERT_EQUALS(row[x], expected[x]);
+			}
+		}
+	}
+
+public:
+	void setUp() {
+		_random.setSeed(1);
+	}
+
+	void test_blend_fill_16bpp() {
+		checkFormat<uint16>(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		checkFormat<uint16>(Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15));
+		checkFormat<uint16>(Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0));
+	}
+
+	void test_blend_fill_32bpp() {
+		checkFormat<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		checkFormat<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+		checkFormat<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0));
+	}
+};
@@ -0,0 +1,86 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/VectorRendererSpec.h"
+#include "graphics/transparent_surface.h"
+#include "gui/ThemeDrawCache.h"
+
+/**
+ * Check that drawing an item through ThemeDrawCache gives the same result
+ * as drawing it directly, at several positions on the surface.
+ */
+class ThemeDrawCacheTestSuite : public CxxTest::TestSuite {
+	enum { kWidth = 80, kHeight = 56, kBackground = 0x18E3 };
+
+	static Graphics::DrawStep::Color makeColor(uint8 r, uint8 g, uint8 b) {
+		Graphics::DrawStep::Color color;
+		color.r = r;
+		color.g = g;
+		color.b = b;
+		color.set = true;
+		return color;
+	}
+
+	static void clearSurface(Graphics::TransparentSurface &surface) {
+		for (int y = 0; y < surface.h; ++y) {
+			for (int x = 0; x < surface.w; ++x)
+				*(uint16 *)surface.getBasePtr(x, y) = kBackground;
+		}
+	}
+
+	public:
+	void test_dithered_gradient() {
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Graphics::VectorRendererSpec<uint16> renderer(format);
+
+		// A gradient over few colors, which is dithered
+		Graphics::DrawStep step;
+		memset(&step, 0, sizeof(step));
+		step.gradColor1 = makeColor(0, 0, 0);
+		step.gradColor2 = makeColor(32, 0, 32);
+		step.autoWidth = step.autoHeight = true;
+		step.radius = 6;
+		step.factor = 1;
+		step.stroke = 1;
+		step.fillMode = Graphics::VectorRenderer::kFillGradient;
+		step.scale = 1 << 16;
+		step.drawingCall = &Graphics::VectorRenderer::drawCallback_ROUNDSQ;
+
+		Graphics::TransparentSurface surface, expected;
+		surface.create(kWidth, kHeight, format);
+		expected.create(kWidth, kHeight, format);
+		renderer.setSurface(&surface);
+
+		GUI::ThemeDrawCache cache;
+		cache.setLimit(4 * surface.h * surface.pitch);
+
+		static const int positions[] = { 4, 5, 6, 7, 10, 13, 6 };
+		int hits = 0;
+		for (uint i = 0; i < ARRAYSIZE(positions); ++i) {
+			const Common::Rect area(positions[i], 8, positions[i] + 48, 48);
+			Common::Rect region = area;
+			region.grow(2);
+
+			clearSurface(surface);
+			renderer.drawStep(area, step);
+			expected.copyFrom(surface);
+
+			clearSurface(surface);
+			const GUI::ThemeDrawCache::Key key(&step, 0, area, region, false, renderer.areShadowsEnabled());
+			if (cache.restore(key, surface, region)) {
+				++hits;
+			} else {
+				GUI::ThemeDrawCache::Entry *entry = cache.startEntry(key, surface, region);
+				renderer.drawStep(area, step);
+				cache.finishEntry(entry, surface);
+			}
+
+			TS_ASSERT_EQUALS(memcmp(surface.getPixels(), expected.getPixels(), surface.pitch * surface.h), 0);
+		}
+
+		// Only the first drawings at even and odd positions are not cached
+		TS_ASSERT_EQUALS(hits, (int)ARRAYSIZE(positions) - 2);
+
+		surface.free();
+		expected.free();
+	}
+};
@@ -0,0 +1,72 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "video/smk_decoder.h"
+
+class SmackerPaletteTestDecoder : public Video::SmackerDecoder {
+public:
+	typedef SmackerVideoTrack TestVideoTrack;
+};
+
+/**
+ * Check when the Smacker video track reports its palette as dirty.
+ */
+class SmackerDecoderTestSuite : public CxxTest::TestSuite {
+	// Unpack a palette chunk which sets all 256 colors to the given one.
+	// The chunk size in the first byte is in units of 4 bytes and includes
+	// the size byte itself.
+	static void unpackPalette(SmackerPaletteTestDecoder::TestVideoTrack &track, byte r, byte g, byte b) {
+		byte chunk[4 * 193];
+		memset(chunk, 0, sizeof(chunk));
+		chunk[0] = 193;
+		for (int i = 0; i < 256; ++i) {
+			chunk[1 + i * 3 + 0] = r;
+			chunk[1 + i * 3 + 1] = g;
+			chunk[1 + i * 3 + 2] = b;
+		}
+
+		Common::MemoryReadStream stream(chunk, sizeof(chunk));
+		track.unpackPalette(&stream);
+		TS_ASSERT_EQUALS(stream.pos(), (int32)sizeof(chunk));
+	}
+
+public:
+	void test_first_palette_is_dirty() {
+		SmackerPaletteTestDecoder::TestVideoTrack track(8, 8, 10, Common::Rational(15), 0, 0);
+		TS_ASSERT(!track.hasDirtyPalette());
+
+		// A video fading in from black starts with an all black palette,
+		// which still has to be applied
+		unpackPalette(track, 0, 0, 0);
+		TS_ASSERT(track.hasDirtyPalette());
+		TS_ASSERT_EQUALS(track.getPalette()[0], 0);
+		TS_ASSERT(!track.hasDirtyPalette());
+	}
+
+	void test_unchanged_palette_is_not_dirty() {
+		SmackerPaletteTestDecoder::TestVideoTrack track(8, 8, 10, Common::Rational(15), 0, 0);
+
+		unpackPalette(track, 10, 20, 30);
+		TS_ASSERT(track.hasDirtyPalette());
+		track.getPalette();
+
+		unpackPalette(track, 10, 20, 30);
+		TS_ASSERT(!track.hasDirtyPalette());
+
+		unpackPalette(track, 10, 20, 31);
+		TS_ASSERT(track.hasDirtyPalette());
+		TS_ASSERT_EQUALS(track.getPalette()[2], 31 * 4 + 31 / 16);
+	}
+
+	void test_rewind_makes_palette_dirty() {
+		SmackerPaletteTestDecoder::TestVideoTrack track(8, 8, 10, Common::Rational(15), 0, 0);
+
+		unpackPalette(track, 10, 20, 30);
+		track.getPalette();
+
+		// The decoder forgets the palette when the video is restarted
+		TS_ASSERT(track.rewind());
+		unpackPalette(track, 10, 20, 30);
+		TS_ASSERT(track.hasDirtyPalette());
+	}
+};
@@ -0,0 +1,136 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+/**
+ * Check the frame writing of VideoDecoder::decodeNextFrameInto against
+ * writing the frame pixel by pixel, for frames which are clipped at each
+ * of the edges, for the supported format conversions and scale factors.
+ */
+class VideoDecoderTestSuite : public CxxTest::TestSuite {
+	enum { kFrameWidth = 7, kFrameHeight = 5, kDstWidth = 12, kDstHeight = 9 };
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		const byte *ptr = (const byte *)surface.getBasePtr(x, y);
+		switch (surface.format.bytesPerPixel) {
+		case 1:
+			return *ptr;
+		case 2:
+			return *(const uint16 *)ptr;
+		default:
+			return *(const uint32 *)ptr;
+		}
+	}
+
+	static void setPixel(Graphics::Surface &surface, int x, int y, uint32 color) {
+		byte *ptr = (byte *)surface.getBasePtr(x, y);
+		switch (surface.format.bytesPerPixel) {
+		case 1:
+			*ptr = color;
+			break;
+		case 2:
+			*(uint16 *)ptr = color;
+			break;
+		default:
+			*(uint32 *)ptr = color;
+			break;
+		}
+	}
+
+	static uint32 convertColor(const Graphics::PixelFormat &srcFormat, const Graphics::PixelFormat &dstFormat, const byte *palette, uint32 color) {
+		if (srcFormat == dstFormat)
+			return color;
+
+		if (srcFormat.bytesPerPixel == 1)
+			return dstFormat.RGBToColor(palette[color * 3], palette[color * 3 + 1], palette[color * 3 + 2]);
+
+		byte a, r, g, b;
+		srcFormat.colorToARGB(color, a, r, g, b);
+		return dstFormat.ARGBToColor(a, r, g, b);
+	}
+
+	void checkFrame(const Graphics::PixelFormat &frameFormat, const Graphics::PixelFormat &dstFormat, const byte *palette) {
+		static const int positions[][2] = {
+			{ 0, 0 }, { 2, 3 }, { -3, 1 }, { 1, -2 }, { 8, 2 }, { 3, 7 }, { -4, -3 }, { 9, 6 }, { -7, 0 }, { 12, 0 }
+		};
+
+		Graphics::Surface frame;
+		frame.create(kFrameWidth, kFrameHeight, frameFormat);
+		for (int y = 0; y < kFrameHeight; ++y) {
+			for (int x = 0; x < kFrameWidth; ++x) {
+				if (frameFormat.bytesPerPixel == 1)
+					setPixel(frame, x, y, y * kFrameWidth + x);
+				else
+					setPixel(frame, x, y, frameFormat.ARGBToColor(255 - x * 30, x * 36, y * 50, (x + y) * 20));
+			}
+		}
+
+		Graphics::Surface dst;
+		dst.create(kDstWidth, kDstHeight, dstFormat);
+
+		for (int scale = 1; scale <= 3; ++scale) {
+			for (uint i = 0; i < ARRAYSIZE(positions); ++i) {
+				const int left = positions[i][0];
+				const int top = positions[i][1];
+				memset(dst.getPixels(), 0xAB, dst.pitch * dst.h);
+				const uint32 background = getPixel(dst, 0, 0);
+
+				TS_ASSERT(Video::VideoDecoder::writeFrameInto(frame, dst, left, top, palette, scale));
+
+				for (int y = 0; y < kDstHeight; ++y) {
+					for (int x = 0; x < kDstWidth; ++x) {
+						uint32 expected = background;
+
+						if (x >= left && x < left + kFrameWidth * scale && y >= top && y < top + kFrameHeight * scale) {
+							const uint32 color = getPixel(frame, (x - left) / scale, (y - top) / scale);
+							expected = convertColor(frameFormat, dstFormat, palette, color);
+						}
+
+						TS_ASSERT_EQUALS(getPixel(dst, x, y), expected);
+					}
+				}
+			}
+		}
+
+		dst.free();
+		frame.free();
+	}
+
+public:
+	void test_same_format() {
+		checkFrame(Graphics::PixelFormat::createFormatCLUT8(), Graphics::PixelFormat::createFormatCLUT8(), 0);
+		checkFrame(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), 0);
+		checkFrame(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), 0);
+	}
+
+	void test_paletted_to_high_color() {
+		byte palette[256 * 3];
+		for (uint i = 0; i < sizeof(palette); ++i)
+			palette[i] = (byte)(i * 7 + 3);
+
+		checkFrame(Graphics::PixelFormat::createFormatCLUT8(), Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), palette);
+		checkFrame(Graphics::PixelFormat::createFormatCLUT8(), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), palette);
+	}
+
+	void test_high_color_conversion() {
+		checkFrame(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), 0);
+		checkFrame(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15), 0);
+		checkFrame(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0), Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24), 0);
+	}
+
+	void test_unsupported_conversion() {
+		Graphics::Surface frame, dst;
+		frame.create(kFrameWidth, kFrameHeight, Graphics::PixelFormat::createFormatCLUT8());
+		dst.create(kDstWidth, kDstHeight, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+
+		// Paletted frames need a palette, and high color ones cannot be
+		// dithered down to 8bpp
+		TS_ASSERT(!Video::VideoDecoder::writeFrameInto(frame, dst, 0, 0, 0));
+		TS_ASSERT(!Video::VideoDecoder::writeFrameInto(dst, frame, 0, 0, 0));
+		TS_ASSERT(!Video::VideoDecoder::writeFrameInto(frame, frame, 0, 0, 0, 0));
+
+		dst.free();
+		frame.free();
+	}
+};
@@ -807,46 +807,70 @@ void AVIDecoder::seekTransparencyFrame(int frame) {
 	transTrack->setCurFrame(frame - 1);
 }
 
+static int getHexDigitValue(byte c) {
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
 byte AVIDecoder::getStreamIndex(uint32 tag) {
-	char string[3];
-	WRITE_BE_UINT16(string, tag >> 16);
-	string[2] = 0;
-	return strtol(string, 0, 16);
+	// The first two characters of the tag are the stream index in hex.
+	// Like strtol(), stop at the first character which is no hex digit.
+	int high = getHexDigitValue(tag >> 24);
+	if (high < 0)
+		return 0;
+
+	int low = getHexDigitValue((tag >> 16) & 0xFF);
+	if (low < 0)
+		return high;
+
+	return (high << 4) | low;
 }
 
 void AVIDecoder::readOldIndex(uint32 size) {
-	uint32 entryCount = size / 16;
+	// The size comes from the file, so don't trust it further than the
+	// data actually left in the stream
+	const int32 remaining = _fileStream->size() - _fileStream->pos();
+	uint32 entryCount = MIN<uint32>(size, MAX<int32>(remaining, 0)) / 16;
 
 	debug(7, "Old Index: %d entries", entryCount);
 
 	if (entryCount == 0)
 		return;
 
-	// Read the first index separately
-	OldIndex firstEntry;
-	firstEntry.id = _fileStream->readUint32BE();
-	firstEntry.flags = _fileStream->readUint32LE();
-	firstEntry.offset = _fileStream->readUint32LE();
-	firstEntry.size = _fileStream->readUint32LE();
+	// Read the whole index with a single read instead of going
+	// through the file stream for every single field
+	byte *indexData = (byte *)malloc(entryCount * 16);
+	if (!indexData) {
+		warning("Failed to allocate the AVI index (%d entries)", entryCount);
+		_fileStream->skip(size);
+		return;
+	}
 
-	// Check if the offset is already absolute
-	// If it's absolute, the offset will equal the start of the movie list
-	bool isAbsolute = firstEntry.offset == _movieListStart;
+	entryCount = _fileStream->read(indexData, entryCount * 16) / 16;
+	_indexEntries.reserve(_indexEntries.size() + entryCount);
 
-	debug(6, "Old index is %s", isAbsolute ? "absolute" : "relative");
+	const byte *entryData = indexData;
+	bool isAbsolute = false;
 
-	if (!isAbsolute)
-		firstEntry.offset += _movieListStart - 4;
+	for (uint32 i = 0; i < entryCount; i++, entryData += 16) {
+		OldIndex indexEntry;
+		indexEntry.id = READ_BE_UINT32(entryData);
+		indexEntry.flags = READ_LE_UINT32(entryData + 4);
+		indexEntry.offset = READ_LE_UINT32(entryData + 8);
+		indexEntry.size = READ_LE_UINT32(entryData + 12);
 
-	debug(7, "Index 0: Tag '%s', Offset = %d, Size = %d (Flags = %d)", tag2str(firstEntry.id), firstEntry.offset, firstEntry.size, firstEntry.flags);
-	_indexEntries.push_back(firstEntry);
+		if (i == 0) {
+			// Check if the offset is already absolute
+			// If it's absolute, the offset will equal the start of the movie list
+			isAbsolute = indexEntry.offset == _movieListStart;
 
-	for (uint32 i = 1; i < entryCount; i++) {
-		OldIndex indexEntry;
-		indexEntry.id = _fileStream->readUint32BE();
-		indexEntry.flags = _fileStream->readUint32LE();
-		indexEntry.offset = _fileStream->readUint32LE();
-		indexEntry.size = _fileStream->readUint32LE();
+			debug(6, "Old index is %s", isAbsolute ? "absolute" : "relative");
+		}
 
 		// Adjust to absolute, if necessary
 		if (!isAbsolute)
@@ -855,6 +879,8 @@ void AVIDecoder::readOldIndex(uint32 size) {
 		_indexEntries.push_back(indexEntry);
 		debug(7, "Index %d: Tag '%s', Offset = %d, Size = %d (Flags = %d)", i, tag2str(indexEntry.id), indexEntry.offset, indexEntry.size, indexEntry.flags);
 	}
+
+	free(indexData);
 }
 
 void AVIDecoder::checkTruemotion1() {
@@ -255,6 +255,12 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 	return r1+r2+1;
 }
 
+// A table decoding several short codes per lookup would still work with the
+// escape markers: they change the values of three leaves, never the shape of
+// the tree, so such a table could hold leaf indices and apply the marker
+// update below for each of them. It is not used because only full blocks
+// take several codes in a row from the same tree, and the full tree holds
+// pairs of 8-bit colors. Its codes seldom fit two to the 8 bits looked up.
 uint32 BigHuffmanTree::getCode(Common::BitStreamMemory8LSB &bs) {
 	byte peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), 8));
 	uint32 *p = &_tree[_prefixtree[peek]];
@@ -526,6 +532,7 @@ SmackerDecoder::SmackerVideoTrack::SmackerVideoTrack(uint32 width, uint32 height
 	_signature = signature;
 	_curFrame = -1;
 	_dirtyPalette = false;
+	_paletteUnpacked = false;
 	_MMapTree = _MClrTree = _FullTree = _TypeTree = 0;
 	memset(_palette, 0, 3 * 256);
 }
@@ -559,6 +566,28 @@ void SmackerDecoder::SmackerVideoTrack::readTrees(Common::BitStreamMemory8LSB &b
 	_TypeTree = new BigHuffmanTree(bs, typeSize);
 }
 
+/**
+ * Little endian masks selecting the pixels set in a 4 bit row of a mono
+ * block, so a whole row can be written with a single store.
+ */
+static const uint32 kMonoRowMasks[16] = {
+	0x00000000, 0x000000FF, 0x0000FF00, 0x0000FFFF,
+	0x00FF0000, 0x00FF00FF, 0x00FFFF00, 0x00FFFFFF,
+	0xFF000000, 0xFF0000FF, 0xFF00FF00, 0xFF00FFFF,
+	0xFFFF0000, 0xFFFF00FF, 0xFFFFFF00, 0xFFFFFFFF
+};
+
+/**
+ * Write one 4 pixel row of a block, given as a little endian value,
+ * repeating it for Y-doubled and Y-interlaced videos.
+ */
+static inline void writeBlockRow(byte *&out, uint32 row, uint stride, uint doubleY) {
+	for (uint j = 0; j < doubleY; ++j) {
+		WRITE_LE_UINT32(out, row);
+		out += stride;
+	}
+}
+
 void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB &bs) {
 	_MMapTree->reset();
 	_MClrTree->reset();
@@ -574,9 +603,8 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 	uint block = 0, blocks = bw*bh;
 
 	byte *out;
-	uint type, run, j, mode;
-	uint32 p1, p2, clr, map;
-	byte hi, lo;
+	uint type, run, mode;
+	uint32 p1, p2, clr, map, hi, lo, col;
 	uint i;
 
 	while (block < blocks) {
@@ -589,16 +617,11 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 				clr = _MClrTree->getCode(bs);
 				map = _MMapTree->getCode(bs);
 				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
-				hi = clr >> 8;
-				lo = clr & 0xff;
+				hi = ((clr >> 8) & 0xff) * 0x01010101;
+				lo = (clr & 0xff) * 0x01010101;
 				for (i = 0; i < 4; i++) {
-					for (j = 0; j < doubleY; j++) {
-						out[0] = (map & 1) ? hi : lo;
-						out[1] = (map & 2) ? hi : lo;
-						out[2] = (map & 4) ? hi : lo;
-						out[3] = (map & 8) ? hi : lo;
-						out += stride;
-					}
+					uint32 mask = kMonoRowMasks[map & 0xf];
+					writeBlockRow(out, (hi & mask) | (lo & ~mask), stride, doubleY);
 					map >>= 4;
 				}
 				++block;
@@ -625,54 +648,28 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 				switch (mode) {
 					case 0:
 						for (i = 0; i < 4; ++i) {
-							p1 = _FullTree->getCode(bs);
-							p2 = _FullTree->getCode(bs);
-							for (j = 0; j < doubleY; ++j) {
-								out[2] = p1 & 0xff;
-								out[3] = p1 >> 8;
-								out[0] = p2 & 0xff;
-								out[1] = p2 >> 8;
-								out += stride;
-							}
+							p1 = _FullTree->getCode(bs) & 0xffff;
+							p2 = _FullTree->getCode(bs) & 0xffff;
+							writeBlockRow(out, p2 | (p1 << 16), stride, doubleY);
 						}
 						break;
 					case 1:
+						// Each color covers two rows of two pixel wide halves
 						p1 = _FullTree->getCode(bs);
-						out[0] = out[1] = p1 & 0xFF;
-						out[2] = out[3] = p1 >> 8;
-						out += stride;
-						out[0] = out[1] = p1 & 0xFF;
-						out[2] = out[3] = p1 >> 8;
-						out += stride;
+						col = (p1 & 0xff) * 0x0101 | ((p1 >> 8) & 0xff) * 0x01010000;
+						writeBlockRow(out, col, stride, 2);
 						p2 = _FullTree->getCode(bs);
-						out[0] = out[1] = p2 & 0xFF;
-						out[2] = out[3] = p2 >> 8;
-						out += stride;
-						out[0] = out[1] = p2 & 0xFF;
-						out[2] = out[3] = p2 >> 8;
-						out += stride;
+						col = (p2 & 0xff) * 0x0101 | ((p2 >> 8) & 0xff) * 0x01010000;
+						writeBlockRow(out, col, stride, 2);
 						break;
 					case 2:
 						for (i = 0; i < 2; i++) {
 							// We first get p2 and then p1
 							// Check ffmpeg thread "[PATCH] Smacker video decoder bug fix"
 							// http://article.gmane.org/gmane.comp.video.ffmpeg.devel/78768
-							p2 = _FullTree->getCode(bs);
-							p1 = _FullTree->getCode(bs);
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
-								out += stride;
-							}
-							for (j = 0; j < doubleY; ++j) {
-								out[0] = p1 & 0xff;
-								out[1] = p1 >> 8;
-								out[2] = p2 & 0xff;
-								out[3] = p2 >> 8;
-								out += stride;
-							}
+							p2 = _FullTree->getCode(bs) & 0xffff;
+							p1 = _FullTree->getCode(bs) & 0xffff;
+							writeBlockRow(out, p1 | (p2 << 16), stride, doubleY * 2);
 						}
 						break;
 				}
@@ -680,19 +677,14 @@ void SmackerDecoder::SmackerVideoTrack::decodeFrame(Common::BitStreamMemory8LSB
 			}
 			break;
 		case SMK_BLOCK_SKIP:
-			while (run-- && block < blocks)
-				block++;
+			// Skip the whole run at once
+			block = MIN(block + run, blocks);
 			break;
 		case SMK_BLOCK_FILL:
-			uint32 col;
-			mode = type >> 8;
+			col = (type >> 8) * 0x01010101;
 			while (run-- && block < blocks) {
 				out = (byte *)_surface->getPixels() + (block / bw) * (stride * 4 * doubleY) + (block % bw) * 4;
-				col = mode * 0x01010101;
-				for (i = 0; i < 4 * doubleY; ++i) {
-					out[0] = out[1] = out[2] = out[3] = col;
-					out += stride;
-				}
+				writeBlockRow(out, col, stride, 4 * doubleY);
 				++block;
 			}
 			break;
@@ -704,7 +696,7 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 	uint startPos = stream->pos();
 	uint32 len = 4 * stream->readByte();
 
-	byte *chunk = (byte *)malloc(len);
+	byte chunk[4 * 255];
 	stream->read(chunk, len);
 	byte *p = chunk;
 
@@ -747,9 +739,14 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 	}
 
 	stream->seek(startPos + len);
-	free(chunk);
 
-	_dirtyPalette = true;
+	// Many videos resend an unchanged palette with every frame, don't
+	// make the engine reapply it in that case. The first palette is
+	// always applied, even if it matches the initial all black one.
+	if (!_paletteUnpacked || memcmp(oldPalette, _palette, 3 * 256) != 0)
+		_dirtyPalette = true;
+
+	_paletteUnpacked = true;
 }
 
 SmackerDecoder::SmackerAudioTrack::SmackerAudioTrack(const AudioInfo &audioInfo, Audio::Mixer::SoundType soundType) :
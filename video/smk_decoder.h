@@ -80,7 +80,7 @@ protected:
 		~SmackerVideoTrack();
 
 		bool isRewindable() const { return true; }
-		bool rewind() { _curFrame = -1; return true; }
+		bool rewind() { _curFrame = -1; _paletteUnpacked = false; return true; }
 
 		uint16 getWidth() const;
 		uint16 getHeight() const;
@@ -107,6 +107,7 @@ protected:
 
 		byte _palette[3 * 256];
 		mutable bool _dirtyPalette;
+		bool _paletteUnpacked;	///< a palette was unpacked since the start of the video
 
 		int _curFrame;
 		uint32 _frameCount;
@@ -27,9 +27,11 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/rect.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
@@ -205,6 +207,170 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+template<typename Color>
+struct IdentityConverter {
+	Color operator()(Color color) const { return color; }
+};
+
+template<typename DstColor>
+struct PaletteConverter {
+	PaletteConverter(const DstColor *lut) : _lut(lut) {}
+	DstColor operator()(byte color) const { return _lut[color]; }
+
+	const DstColor *_lut;
+};
+
+template<typename SrcColor, typename DstColor>
+struct FormatConverter {
+	FormatConverter(const Graphics::PixelFormat &srcFormat, const Graphics::PixelFormat &dstFormat) : _srcFormat(srcFormat), _dstFormat(dstFormat) {}
+
+	DstColor operator()(SrcColor color) const {
+		byte a, r, g, b;
+		_srcFormat.colorToARGB(color, a, r, g, b);
+		return _dstFormat.ARGBToColor(a, r, g, b);
+	}
+
+	const Graphics::PixelFormat _srcFormat, _dstFormat;
+};
+
+/**
+ * Write the part of the source frame placed at (x, y) and scaled by the
+ * given factor which falls into dstRect, converting each pixel on the way.
+ * Rows repeated by the scaling are copied instead of being converted again.
+ */
+template<typename SrcColor, typename DstColor, class Converter>
+static void writeFrame(Graphics::Surface &dst, const Graphics::Surface &src, const Common::Rect &dstRect, int x, int y, int scale, const Converter &convert) {
+	const int width = dstRect.width();
+
+	for (int row = 0; row < dstRect.height(); row++) {
+		const int dstY = dstRect.top + row;
+		DstColor *dstPixel = (DstColor *)dst.getBasePtr(dstRect.left, dstY);
+
+		if (row > 0 && (dstY - y) % scale != 0) {
+			memcpy(dstPixel, dst.getBasePtr(dstRect.left, dstY - 1), width * sizeof(DstColor));
+			continue;
+		}
+
+		const SrcColor *srcPixel = (const SrcColor *)src.getBasePtr((dstRect.left - x) / scale, (dstY - y) / scale);
+
+		if (scale == 1) {
+			for (int col = 0; col < width; col++)
+				*dstPixel++ = convert(*srcPixel++);
+			continue;
+		}
+
+		// The clipping may start in the middle of a scaled pixel
+		int repeat = scale - (dstRect.left - x) % scale;
+		DstColor color = convert(*srcPixel);
+		for (int col = 0; col < width; col++) {
+			*dstPixel++ = color;
+			if (--repeat == 0 && col + 1 < width) {
+				color = convert(*++srcPixel);
+				repeat = scale;
+			}
+		}
+	}
+}
+
+template<typename DstColor>
+static void writePalettedFrame(Graphics::Surface &dst, const Graphics::Surface &src, const Common::Rect &dstRect, int x, int y, int scale, const byte *palette) {
+	DstColor lut[256];
+	for (uint i = 0; i < 256; i++)
+		lut[i] = dst.format.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+
+	writeFrame<byte, DstColor>(dst, src, dstRect, x, y, scale, PaletteConverter<DstColor>(lut));
+}
+
+template<typename SrcColor>
+static void writeConvertedFrame(Graphics::Surface &dst, const Graphics::Surface &src, const Common::Rect &dstRect, int x, int y, int scale) {
+	if (dst.format.bytesPerPixel == 2)
+		writeFrame<SrcColor, uint16>(dst, src, dstRect, x, y, scale, FormatConverter<SrcColor, uint16>(src.format, dst.format));
+	else
+		writeFrame<SrcColor, uint32>(dst, src, dstRect, x, y, scale, FormatConverter<SrcColor, uint32>(src.format, dst.format));
+}
+
+bool VideoDecoder::decodeNextFrameInto(Graphics::Surface &dst, int x, int y, int scale) {
+	// Check before decoding that the frame can be written, so that no
+	// frame is skipped when it cannot
+	VideoTrack *track = _nextVideoTrack;
+	if (track) {
+		const byte *palette = _palette ? _palette : track->getPalette();
+		if (!canWriteFrameInto(track->getPixelFormat(), dst.format, palette != 0, scale))
+			return false;
+	}
+
+	const Graphics::Surface *frame = decodeNextFrame();
+	if (!frame)
+		return false;
+
+	return writeFrameInto(*frame, dst, x, y, _palette ? _palette : track->getPalette(), scale);
+}
+
+bool VideoDecoder::canWriteFrameInto(const Graphics::PixelFormat &frameFormat, const Graphics::PixelFormat &dstFormat, bool hasPalette, int scale) {
+	if (scale < 1)
+		return false;
+
+	const byte srcBpp = frameFormat.bytesPerPixel;
+	const byte dstBpp = dstFormat.bytesPerPixel;
+
+	// Unscaled frames in the destination format are copied as they are
+	if (frameFormat == dstFormat && scale == 1)
+		return true;
+
+	if (frameFormat == dstFormat)
+		return srcBpp == 1 || srcBpp == 2 || srcBpp == 4;
+
+	// We don't support dithering high color frames here, only expanding
+	// paletted frames to high color
+	if (srcBpp == 1)
+		return hasPalette && (dstBpp == 2 || dstBpp == 4);
+
+	return (srcBpp == 2 || srcBpp == 4) && (dstBpp == 2 || dstBpp == 4);
+}
+
+bool VideoDecoder::writeFrameInto(const Graphics::Surface &frame, Graphics::Surface &dst, int x, int y, const byte *palette, int scale) {
+	if (!canWriteFrameInto(frame.format, dst.format, palette != 0, scale))
+		return false;
+
+	Common::Rect dstRect(x, y, x + frame.w * scale, y + frame.h * scale);
+	dstRect.clip(Common::Rect(dst.w, dst.h));
+	if (dstRect.isEmpty())
+		return true;
+
+	const byte srcBpp = frame.format.bytesPerPixel;
+	const byte dstBpp = dst.format.bytesPerPixel;
+
+	if (frame.format == dst.format) {
+		if (scale == 1) {
+			const byte *src = (const byte *)frame.getBasePtr(dstRect.left - x, dstRect.top - y);
+			byte *dstPtr = (byte *)dst.getBasePtr(dstRect.left, dstRect.top);
+
+			for (int row = 0; row < dstRect.height(); row++) {
+				memcpy(dstPtr, src, dstRect.width() * dstBpp);
+				src += frame.pitch;
+				dstPtr += dst.pitch;
+			}
+		} else if (dstBpp == 1) {
+			writeFrame<byte, byte>(dst, frame, dstRect, x, y, scale, IdentityConverter<byte>());
+		} else if (dstBpp == 2) {
+			writeFrame<uint16, uint16>(dst, frame, dstRect, x, y, scale, IdentityConverter<uint16>());
+		} else {
+			writeFrame<uint32, uint32>(dst, frame, dstRect, x, y, scale, IdentityConverter<uint32>());
+		}
+	} else if (srcBpp == 1) {
+		if (dstBpp == 2)
+			writePalettedFrame<uint16>(dst, frame, dstRect, x, y, scale, palette);
+		else
+			writePalettedFrame<uint32>(dst, frame, dstRect, x, y, scale, palette);
+	} else if (srcBpp == 2) {
+		writeConvertedFrame<uint16>(dst, frame, dstRect, x, y, scale);
+	} else {
+		writeConvertedFrame<uint32>(dst, frame, dstRect, x, y, scale);
+	}
+
+	return true;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
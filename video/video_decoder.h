@@ -355,6 +355,47 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame and write it into a caller supplied surface.
+	 *
+	 * The frame is converted to the pixel format of the destination and
+	 * scaled by an integer factor in a single pass, instead of creating a
+	 * converted copy with Surface::convertTo() and scaling that. The frame
+	 * is clipped against the destination surface.
+	 *
+	 * Palette handling is unchanged: when writing to an 8bpp surface, the
+	 * caller is still responsible for applying getPalette() when the
+	 * palette is dirty.
+	 *
+	 * @param dst	the surface to write the frame to
+	 * @param x		the x coordinate of the frame inside dst
+	 * @param y		the y coordinate of the frame inside dst
+	 * @param scale	the factor to scale the frame by
+	 * @return true if a frame was written, false if no frame was available
+	 *         or if it cannot be converted to the format of dst. In the
+	 *         latter case, no frame is decoded, so the caller can still
+	 *         decode it with decodeNextFrame().
+	 * @note As with decodeNextFrame(), the last frame should be kept on
+	 *       screen when this returns false.
+	 */
+	bool decodeNextFrameInto(Graphics::Surface &dst, int x = 0, int y = 0, int scale = 1);
+
+	/**
+	 * Write a frame into a surface as decodeNextFrameInto() does, using
+	 * the given palette to expand paletted frames to high color. This is
+	 * also useful for players of formats without a VideoDecoder.
+	 *
+	 * @return true if the frame was written, false if it cannot be
+	 *         converted to the format of dst
+	 */
+	static bool writeFrameInto(const Graphics::Surface &frame, Graphics::Surface &dst, int x, int y, const byte *palette, int scale = 1);
+
+	/**
+	 * Check whether writeFrameInto() can write frames of one pixel format
+	 * into surfaces of another, with or without a palette.
+	 */
+	static bool canWriteFrameInto(const Graphics::PixelFormat &frameFormat, const Graphics::PixelFormat &dstFormat, bool hasPalette, int scale = 1);
+
 	/**
 	 * Set the default high color format for videos that convert from YUV.
 	 *